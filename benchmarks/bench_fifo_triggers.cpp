@@ -0,0 +1,300 @@
+/*
+ * FIFO trigger-level benchmark.
+ *
+ * Streams a payload full duplex through one port on the MMIO burst path
+ * against a simulated XR17V358 channel: each character time the line shifts
+ * one byte out of the device TX FIFO and one byte into the RX FIFO. The
+ * simulated channel raises RX data / RX time-out / TX empty interrupts from
+ * the programmed trigger levels, and every interrupt is one
+ * serial_driver_service_event() call. Prints service events per kilobyte
+ * moved and the worst RX latency (arrival in the device FIFO to the reader)
+ * for the reset-default triggers and each serial_fifo_profile_t.
+ *
+ * The channel model here is separate from serial_driver_sim_advance() on
+ * purpose: the simulator only moves bytes through the software FIFOs and
+ * does not model the MMIO burst windows, trigger levels, RX time-out or the
+ * INT0-INT3 registers, which are exactly what this benchmark measures.
+ * Time is counted in character times, so the baud rate only scales the
+ * reported latency.
+ *
+ * Usage: device_driver_bench_fifo_triggers [baud] [payload_kib]
+ */
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern "C"
+{
+#include "device_driver/device_driver.h"
+#include "device_driver/hw_abstraction.h"
+}
+
+namespace
+{
+
+constexpr size_t kPort = SERIAL_PORT_0;
+constexpr unsigned kBitsPerChar = 10U; /* 8N1 */
+constexpr unsigned kRxTimeoutChars = 4U;
+
+xr17c358_channel_register_map_t g_registers[UART_DEVICE_COUNT];
+
+uart_error_t BenchMapper(size_t port_index, uart_device_t *uart_device,
+                         uart_device_info_t *device_info)
+{
+    if (uart_device == nullptr || device_info == nullptr ||
+        port_index >= UART_DEVICE_COUNT)
+    {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    uart_device->registers = &g_registers[port_index];
+    device_info->uart_base_address =
+        reinterpret_cast<uintptr_t>(&g_registers[port_index]);
+    device_info->device_name = "bench-uart";
+    return UART_ERROR_NONE;
+}
+
+struct RunStats
+{
+    uint64_t events;
+    uint64_t bytes;
+    uint64_t worst_rx_latency_chars;
+    uint64_t overruns;
+};
+
+void RaiseInterrupt(uint32_t source)
+{
+    xr17v358_device_config_registers_t &config = g_registers[0].device_config;
+    const uint32_t sources = source << (kPort * XR17V358_INT_SOURCE_BITS);
+
+    config.generic.int0 = static_cast<uint8_t>(XR17V358_INT0_CHANNEL_BIT(kPort));
+    config.generic.int1 = static_cast<uint8_t>(sources);
+    config.generic.int2 = static_cast<uint8_t>(sources >> 8U);
+    config.generic.int3 = static_cast<uint8_t>(sources >> 16U);
+}
+
+RunStats Run(serial_descriptor_t descriptor, size_t payload_bytes)
+{
+    xr17c358_channel_register_map_t &registers = g_registers[kPort];
+    const uint8_t tx_trigger = registers.uart.txcnt_or_txtrg.txtrg;
+    const uint8_t rx_trigger = registers.uart.rxcnt_or_rxtrg.rxtrg;
+    std::vector<uint8_t> payload(payload_bytes);
+    std::array<serial_poll_result_t, UART_DEVICE_COUNT> results{};
+    uint8_t scratch[XR17V358_FIFO_DEPTH];
+    RunStats stats{};
+    size_t written = 0U;
+    size_t line_tx = 0U;
+    size_t line_rx = 0U;
+    size_t app_rx = 0U;
+    size_t device_tx = 0U;
+    size_t device_rx = 0U;
+    unsigned rx_idle_chars = 0U;
+    bool tx_armed = true;
+
+    for (size_t i = 0U; i < payload.size(); ++i)
+    {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+
+    for (uint64_t now = 0U; line_tx < payload_bytes || app_rx < payload_bytes;
+         ++now)
+    {
+        if (now > 4U * payload_bytes + XR17V358_FIFO_DEPTH)
+        {
+            std::fprintf(stderr, "Stream stalled at %zu/%zu bytes.\n",
+                         std::min(line_tx, app_rx), payload_bytes);
+            break;
+        }
+
+        size_t moved = 0U;
+        uint32_t source = XR17V358_INT_SOURCE_NONE;
+
+        /* Application keeps the TX ring topped up. */
+        if (written < payload_bytes)
+        {
+            (void)serial_driver_write(descriptor, &payload[written],
+                                      payload_bytes - written, &moved);
+            written += moved;
+        }
+
+        /* One character time on the wire, both directions. */
+        if (device_tx > 0U)
+        {
+            device_tx -= 1U;
+            line_tx += 1U;
+        }
+        if (line_rx < payload_bytes)
+        {
+            if (device_rx < XR17V358_FIFO_DEPTH)
+            {
+                registers.fifo_data.rx_data[device_rx] =
+                    static_cast<uint8_t>(line_rx);
+                device_rx += 1U;
+            }
+            else
+            {
+                stats.overruns += 1U;
+            }
+            line_rx += 1U;
+            rx_idle_chars = 0U;
+        }
+        else
+        {
+            rx_idle_chars += 1U;
+        }
+
+        if (device_rx >= rx_trigger)
+        {
+            source = XR17V358_INT_SOURCE_RX_LINE_STATUS;
+        }
+        else if (device_rx > 0U && rx_idle_chars >= kRxTimeoutChars)
+        {
+            source = XR17V358_INT_SOURCE_RX_TIMEOUT;
+        }
+        else if (tx_armed && device_tx <= tx_trigger && line_tx < written)
+        {
+            source = XR17V358_INT_SOURCE_TX_EMPTY;
+            tx_armed = false;
+        }
+        if (source == XR17V358_INT_SOURCE_NONE)
+        {
+            continue;
+        }
+
+        stats.events += 1U;
+        RaiseInterrupt(source);
+        registers.uart.txcnt_or_txtrg.txcnt = static_cast<uint8_t>(device_tx);
+        registers.uart.rxcnt_or_rxtrg.rxcnt = static_cast<uint8_t>(device_rx);
+        (void)serial_driver_service_event(0U, &g_registers[0].device_config,
+                                          results.data(), results.size(),
+                                          &moved);
+        g_registers[0].device_config.generic.int0 = 0U;
+
+        for (size_t i = 0U; i < moved; ++i)
+        {
+            device_tx += results[i].tx_bytes;
+            std::memmove(const_cast<uint8_t *>(registers.fifo_data.rx_data),
+                         const_cast<const uint8_t *>(
+                             &registers.fifo_data.rx_data[results[i].rx_bytes]),
+                         device_rx - results[i].rx_bytes);
+            device_rx -= results[i].rx_bytes;
+        }
+        if (device_tx > tx_trigger)
+        {
+            tx_armed = true;
+        }
+
+        /* Byte n arrived in the device FIFO at character time n; the oldest
+         * byte of each read waited longest. */
+        while (serial_driver_read(descriptor, scratch, sizeof(scratch),
+                                  &moved) == SERIAL_DRIVER_OK)
+        {
+            stats.worst_rx_latency_chars = std::max<uint64_t>(
+                stats.worst_rx_latency_chars, now - app_rx);
+            app_rx += moved;
+        }
+    }
+
+    stats.bytes = 2U * payload_bytes;
+    return stats;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned long baud = 921600UL;
+    size_t payload_kib = 64U;
+
+    if (argc > 1)
+    {
+        baud = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2)
+    {
+        payload_kib = std::strtoul(argv[2], nullptr, 10);
+    }
+    if (baud == 0UL || payload_kib == 0U)
+    {
+        std::fprintf(stderr, "Baud and payload size must be non-zero.\n");
+        return 1;
+    }
+
+    if (serial_driver_hw_set_mapper(BenchMapper) != UART_ERROR_NONE)
+    {
+        std::fprintf(stderr, "Failed to install benchmark mapper.\n");
+        return 1;
+    }
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    if (descriptor == SERIAL_DESCRIPTOR_INVALID ||
+        serial_driver_set_data_path(descriptor, SERIAL_DATA_PATH_MMIO_BURST) !=
+            SERIAL_DRIVER_OK ||
+        serial_driver_set_poll_policy(descriptor,
+                                      SERIAL_POLL_POLICY_RX_PRIORITY) !=
+            SERIAL_DRIVER_OK)
+    {
+        std::fprintf(stderr, "Failed to initialize port %zu.\n", kPort);
+        return 1;
+    }
+
+    const double char_us = 1.0e6 * kBitsPerChar / static_cast<double>(baud);
+    std::printf("%lu baud, %zu KiB each way, %.2f us per character\n", baud,
+                payload_kib, char_us);
+    std::printf("%-10s %6s %6s %10s %12s %14s %9s\n", "setting", "rx_trg",
+                "tx_trg", "events", "events/KiB", "max_rx_lat_us", "overruns");
+
+    for (int setting = -1; setting <= SERIAL_FIFO_PROFILE_THROUGHPUT;
+         ++setting)
+    {
+        const char *name = "reset";
+        serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+        if (setting < 0)
+        {
+            /* 16550 reset behaviour: RX interrupt per byte, TX on empty. */
+            status = serial_driver_set_fifo_triggers(descriptor, 0U, 1U);
+            if (status == SERIAL_DRIVER_OK)
+            {
+                status = serial_driver_set_poll_budget(
+                    descriptor, UART_DEVICE_FIFO_SIZE_BYTES,
+                    UART_DEVICE_FIFO_SIZE_BYTES);
+            }
+        }
+        else
+        {
+            name = (setting == SERIAL_FIFO_PROFILE_LATENCY) ? "latency"
+                                                           : "throughput";
+            status = serial_driver_apply_fifo_profile(
+                descriptor, static_cast<serial_fifo_profile_t>(setting));
+        }
+        if (status != SERIAL_DRIVER_OK)
+        {
+            std::fprintf(stderr, "Failed to apply setting %s.\n", name);
+            return 1;
+        }
+
+        const unsigned rx_trigger =
+            g_registers[kPort].uart.rxcnt_or_rxtrg.rxtrg;
+        const unsigned tx_trigger =
+            g_registers[kPort].uart.txcnt_or_txtrg.txtrg;
+        const RunStats stats = Run(descriptor, payload_kib * 1024U);
+
+        std::printf("%-10s %6u %6u %10llu %12.2f %14.1f %9llu\n", name,
+                    rx_trigger, tx_trigger,
+                    static_cast<unsigned long long>(stats.events),
+                    static_cast<double>(stats.events) * 1024.0 /
+                        static_cast<double>(stats.bytes),
+                    static_cast<double>(stats.worst_rx_latency_chars) *
+                        char_us,
+                    static_cast<unsigned long long>(stats.overruns));
+    }
+
+    serial_driver_hw_reset_mapper();
+    return 0;
+}
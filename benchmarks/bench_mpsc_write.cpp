@@ -0,0 +1,234 @@
+/*
+ * Multi-producer serial_driver_write() benchmark.
+ *
+ * Scales the number of writer threads sharing one descriptor from 1 to 16 and
+ * reports aggregate throughput and per-call latency percentiles for:
+ *   - mpsc:  SERIAL_WRITE_MODE_MULTI_PRODUCER (lock-free reservation/commit)
+ *   - mutex: SERIAL_WRITE_MODE_SINGLE_PRODUCER behind one std::mutex
+ *
+ * A dedicated poller thread drains the TX ring through serial_driver_poll()
+ * and discards the write FIFO, standing in for the UART.
+ *
+ * Usage: device_driver_bench_mpsc_write [messages_per_writer]
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include "device_driver/device_driver.h"
+#include "device_driver/hw_abstraction.h"
+}
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kPort = SERIAL_PORT_0;
+constexpr size_t kMessageBytes = 32U;
+
+xr17c358_channel_register_map_t g_registers[UART_DEVICE_COUNT];
+
+uart_error_t BenchMapper(size_t port_index, uart_device_t *uart_device,
+                         uart_device_info_t *device_info)
+{
+    if (uart_device == nullptr || device_info == nullptr ||
+        port_index >= UART_DEVICE_COUNT)
+    {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    uart_device->registers = &g_registers[port_index];
+    device_info->uart_base_address =
+        reinterpret_cast<uintptr_t>(&g_registers[port_index]);
+    device_info->device_name = "bench-uart";
+    return UART_ERROR_NONE;
+}
+
+void DiscardWriteFifo(size_t port_index)
+{
+    uart_byte_fifo_t *fifo = &uart_fifo_map.write_fifos[port_index];
+
+    fifo->head = 0U;
+    fifo->tail = 0U;
+    fifo->count = 0U;
+}
+
+struct RunResult
+{
+    double seconds;
+    std::vector<uint64_t> latencies_ns;
+};
+
+RunResult Run(serial_descriptor_t descriptor, size_t writers,
+              size_t messages_per_writer, bool use_mutex)
+{
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> ready{0U};
+    std::atomic<bool> go{false};
+    std::mutex write_lock;
+    std::vector<std::vector<uint64_t>> latencies(writers);
+    std::vector<std::thread> threads;
+
+    std::thread poller([descriptor, &stop] {
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            size_t tx_bytes = 0U;
+            size_t rx_bytes = 0U;
+
+            (void)serial_driver_poll(descriptor, UART_DEVICE_FIFO_SIZE_BYTES,
+                                     0U, &tx_bytes, &rx_bytes);
+            DiscardWriteFifo(kPort);
+            if (tx_bytes == 0U)
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (size_t writer = 0U; writer < writers; ++writer)
+    {
+        latencies[writer].reserve(messages_per_writer);
+        threads.emplace_back([&, writer] {
+            uint8_t message[kMessageBytes];
+
+            std::memset(message, static_cast<int>(writer), sizeof(message));
+            ready.fetch_add(1U);
+            while (!go.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            for (size_t i = 0U; i < messages_per_writer; ++i)
+            {
+                const Clock::time_point start = Clock::now();
+                for (;;)
+                {
+                    size_t written = 0U;
+                    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+                    if (use_mutex)
+                    {
+                        std::lock_guard<std::mutex> guard(write_lock);
+                        status = serial_driver_write(descriptor, message,
+                                                     sizeof(message), &written);
+                    }
+                    else
+                    {
+                        status = serial_driver_write(descriptor, message,
+                                                     sizeof(message), &written);
+                    }
+                    if (status == SERIAL_DRIVER_OK)
+                    {
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+                latencies[writer].push_back(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::now() - start)
+                        .count()));
+            }
+        });
+    }
+
+    while (ready.load() != writers)
+    {
+        std::this_thread::yield();
+    }
+    const Clock::time_point begin = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    const Clock::time_point end = Clock::now();
+    stop = true;
+    poller.join();
+
+    RunResult result;
+    result.seconds = std::chrono::duration<double>(end - begin).count();
+    for (const std::vector<uint64_t> &samples : latencies)
+    {
+        result.latencies_ns.insert(result.latencies_ns.end(), samples.begin(),
+                                   samples.end());
+    }
+    std::sort(result.latencies_ns.begin(), result.latencies_ns.end());
+    return result;
+}
+
+double PercentileUs(const std::vector<uint64_t> &sorted, double percentile)
+{
+    if (sorted.empty())
+    {
+        return 0.0;
+    }
+    const size_t index = std::min(
+        sorted.size() - 1U,
+        static_cast<size_t>(percentile / 100.0 *
+                            static_cast<double>(sorted.size())));
+    return static_cast<double>(sorted[index]) / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    size_t messages_per_writer = 20000U;
+    const size_t writer_counts[] = {1U, 2U, 4U, 8U, 16U};
+
+    if (argc > 1)
+    {
+        messages_per_writer = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    if (serial_driver_hw_set_mapper(BenchMapper) != UART_ERROR_NONE)
+    {
+        std::fprintf(stderr, "Failed to install benchmark mapper.\n");
+        return 1;
+    }
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    if (descriptor == SERIAL_DESCRIPTOR_INVALID)
+    {
+        std::fprintf(stderr, "Failed to initialize benchmark port.\n");
+        return 1;
+    }
+
+    std::printf("%-6s %7s %12s %10s %10s %10s %10s\n", "mode", "writers",
+                "msgs/s", "MB/s", "p50_us", "p99_us", "p99.9_us");
+    for (const bool use_mutex : {false, true})
+    {
+        (void)serial_driver_set_write_mode(
+            descriptor, use_mutex ? SERIAL_WRITE_MODE_SINGLE_PRODUCER
+                                  : SERIAL_WRITE_MODE_MULTI_PRODUCER);
+        for (const size_t writers : writer_counts)
+        {
+            const RunResult result =
+                Run(descriptor, writers, messages_per_writer, use_mutex);
+            const double messages =
+                static_cast<double>(writers * messages_per_writer);
+
+            std::printf("%-6s %7zu %12.0f %10.2f %10.2f %10.2f %10.2f\n",
+                        use_mutex ? "mutex" : "mpsc", writers,
+                        messages / result.seconds,
+                        messages * kMessageBytes / result.seconds / 1.0e6,
+                        PercentileUs(result.latencies_ns, 50.0),
+                        PercentileUs(result.latencies_ns, 99.0),
+                        PercentileUs(result.latencies_ns, 99.9));
+        }
+    }
+
+    serial_driver_hw_reset_mapper();
+    return 0;
+}
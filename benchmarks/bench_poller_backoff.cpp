@@ -0,0 +1,214 @@
+/*
+ * Poller thread backoff benchmark.
+ *
+ * Runs the driver-owned poller thread against one port on the MMIO burst
+ * path (a memory-backed channel whose TX FIFO never fills) and sends one
+ * byte at a fixed interval. Each send is timed from serial_driver_write()
+ * until the port's eventfd reports the TX queue drained, i.e. until the
+ * poller noticed the byte and moved it. For every load level it prints the
+ * median and 99th percentile of that wakeup latency and the CPU time the
+ * poller burned, for the adaptive default backoff and for the fixed 1 ms
+ * sleep loop applications typically write by hand.
+ *
+ * Usage: device_driver_bench_poller_backoff [milliseconds_per_level]
+ */
+#include <poll.h>
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include "device_driver/device_driver.h"
+#include "device_driver/hw_abstraction.h"
+}
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kPort = SERIAL_PORT_0;
+constexpr size_t kMaxMessages = 5000U;
+
+xr17c358_channel_register_map_t g_registers[UART_DEVICE_COUNT];
+
+uart_error_t BenchMapper(size_t port_index, uart_device_t *uart_device,
+                         uart_device_info_t *device_info)
+{
+    if (uart_device == nullptr || device_info == nullptr ||
+        port_index >= UART_DEVICE_COUNT)
+    {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    uart_device->registers = &g_registers[port_index];
+    device_info->uart_base_address =
+        reinterpret_cast<uintptr_t>(&g_registers[port_index]);
+    device_info->device_name = "bench-uart";
+    return UART_ERROR_NONE;
+}
+
+double CpuSeconds(clockid_t clock)
+{
+    struct timespec now = {};
+
+    (void)clock_gettime(clock, &now);
+    return static_cast<double>(now.tv_sec) +
+           static_cast<double>(now.tv_nsec) * 1.0e-9;
+}
+
+struct LevelStats
+{
+    double p50_us;
+    double p99_us;
+    double poller_cpu_percent;
+    serial_poller_stats_t poller;
+};
+
+bool RunLevel(serial_descriptor_t descriptor, int event_fd,
+              const serial_poller_config_t &config,
+              std::chrono::microseconds interval,
+              std::chrono::milliseconds duration, LevelStats *out)
+{
+    const size_t messages = std::max<size_t>(
+        20U, std::min<size_t>(kMaxMessages, duration / interval));
+    std::vector<double> latencies_us;
+    const uint8_t byte = 0x55U;
+    uint32_t events = 0U;
+
+    latencies_us.reserve(messages);
+    if (serial_driver_start_poller(&config) != SERIAL_DRIVER_OK)
+    {
+        return false;
+    }
+    (void)serial_driver_ack_event_fd(descriptor, &events);
+
+    const Clock::time_point begin = Clock::now();
+    const double process_begin = CpuSeconds(CLOCK_PROCESS_CPUTIME_ID);
+    const double self_begin = CpuSeconds(CLOCK_THREAD_CPUTIME_ID);
+    Clock::time_point next = begin;
+
+    for (size_t i = 0U; i < messages; ++i)
+    {
+        struct pollfd ready = {event_fd, POLLIN, 0};
+        size_t written = 0U;
+
+        next += interval;
+        std::this_thread::sleep_until(next);
+
+        const Clock::time_point sent = Clock::now();
+        if (serial_driver_write(descriptor, &byte, 1U, &written) !=
+                SERIAL_DRIVER_OK ||
+            poll(&ready, 1U, 1000) != 1)
+        {
+            (void)serial_driver_stop_poller();
+            return false;
+        }
+        latencies_us.push_back(
+            std::chrono::duration<double, std::micro>(Clock::now() - sent)
+                .count());
+        (void)serial_driver_ack_event_fd(descriptor, &events);
+    }
+
+    const double wall =
+        std::chrono::duration<double>(Clock::now() - begin).count();
+    const double poller_cpu =
+        (CpuSeconds(CLOCK_PROCESS_CPUTIME_ID) - process_begin) -
+        (CpuSeconds(CLOCK_THREAD_CPUTIME_ID) - self_begin);
+    (void)serial_driver_get_poller_stats(&out->poller);
+    (void)serial_driver_stop_poller();
+
+    std::sort(latencies_us.begin(), latencies_us.end());
+    out->p50_us = latencies_us[latencies_us.size() / 2U];
+    out->p99_us = latencies_us[(latencies_us.size() * 99U) / 100U];
+    out->poller_cpu_percent = 100.0 * poller_cpu / wall;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned long level_ms = 300UL;
+    serial_event_config_t event_config = {};
+    int event_fd = -1;
+
+    if (argc > 1)
+    {
+        level_ms = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (level_ms == 0UL)
+    {
+        std::fprintf(stderr, "Run time per level must be non-zero.\n");
+        return 1;
+    }
+
+    if (serial_driver_hw_set_mapper(BenchMapper) != UART_ERROR_NONE)
+    {
+        std::fprintf(stderr, "Failed to install benchmark mapper.\n");
+        return 1;
+    }
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    event_config.rx_threshold = 1U;
+    event_config.tx_low_water = 0U;
+    if (descriptor == SERIAL_DESCRIPTOR_INVALID ||
+        serial_driver_set_data_path(descriptor, SERIAL_DATA_PATH_MMIO_BURST) !=
+            SERIAL_DRIVER_OK ||
+        serial_driver_open_event_fd(descriptor, &event_config, &event_fd) !=
+            SERIAL_DRIVER_OK)
+    {
+        std::fprintf(stderr, "Failed to initialize port %zu.\n", kPort);
+        return 1;
+    }
+
+    const serial_poller_config_t adaptive = {-1, 1024U, 4096U, 256U, 100U};
+    const serial_poller_config_t fixed_sleep = {-1, 0U, 0U, 0U, 1000U};
+    const struct
+    {
+        const char *name;
+        const serial_poller_config_t *config;
+    } modes[] = {{"adaptive", &adaptive}, {"sleep-1ms", &fixed_sleep}};
+    const std::chrono::microseconds intervals[] = {
+        std::chrono::microseconds(20), std::chrono::microseconds(200),
+        std::chrono::microseconds(2000), std::chrono::microseconds(20000)};
+
+    std::printf("%-10s %12s %10s %10s %8s %10s %10s %10s\n", "poller",
+                "interval_us", "p50_us", "p99_us", "cpu_%", "pauses",
+                "yields", "sleeps");
+    for (const auto &mode : modes)
+    {
+        for (const std::chrono::microseconds interval : intervals)
+        {
+            LevelStats stats = {};
+
+            if (!RunLevel(descriptor, event_fd, *mode.config, interval,
+                          std::chrono::milliseconds(level_ms), &stats))
+            {
+                std::fprintf(stderr, "Run failed for %s at %lld us.\n",
+                             mode.name,
+                             static_cast<long long>(interval.count()));
+                return 1;
+            }
+            std::printf("%-10s %12lld %10.1f %10.1f %8.1f %10llu %10llu "
+                        "%10llu\n",
+                        mode.name, static_cast<long long>(interval.count()),
+                        stats.p50_us, stats.p99_us, stats.poller_cpu_percent,
+                        static_cast<unsigned long long>(stats.poller.pauses),
+                        static_cast<unsigned long long>(stats.poller.yields),
+                        static_cast<unsigned long long>(stats.poller.sleeps));
+        }
+    }
+
+    (void)serial_driver_close_event_fd(descriptor);
+    serial_driver_hw_reset_mapper();
+    return 0;
+}
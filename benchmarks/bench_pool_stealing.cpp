@@ -0,0 +1,199 @@
+/*
+ * Work-stealing pool benchmark.
+ *
+ * Built against a 32-port driver (four XR17V358 cards). Every port runs the
+ * MMIO burst path over a memory-backed channel whose TX FIFO never fills, and
+ * one producer thread per card keeps its card's TX rings full. Traffic is
+ * skewed: in each phase one channel position is hot on every card (ports h,
+ * h+8, h+16, h+24) and the rest trickle, and the hot position moves on every
+ * phase. Ports are dealt round-robin to workers, so all hot ports of a phase
+ * share one home worker. Prints drained throughput and steals for 1, 2, 4
+ * and 8 workers, with stealing and with a static partition.
+ *
+ * Usage: device_driver_bench_pool_stealing [milliseconds_per_run]
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include "device_driver/device_driver.h"
+#include "device_driver/hw_abstraction.h"
+}
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kCards = UART_DEVICE_COUNT / XR17V358_UART_CHANNEL_COUNT;
+constexpr size_t kChunkBytes = 256U;
+constexpr std::chrono::milliseconds kPhase(20);
+constexpr unsigned kColdEvery = 64U;
+
+static_assert(kCards > 0U, "benchmark needs at least one full card");
+
+xr17c358_channel_register_map_t g_registers[UART_DEVICE_COUNT];
+
+uart_error_t BenchMapper(size_t port_index, uart_device_t *uart_device,
+                         uart_device_info_t *device_info)
+{
+    if (uart_device == nullptr || device_info == nullptr ||
+        port_index >= UART_DEVICE_COUNT)
+    {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    uart_device->registers = &g_registers[port_index];
+    device_info->uart_base_address =
+        reinterpret_cast<uintptr_t>(&g_registers[port_index]);
+    device_info->device_name = "bench-uart";
+    return UART_ERROR_NONE;
+}
+
+/* Writes the skewed load for one card's ports; returns bytes queued. */
+uint64_t RunProducer(const serial_descriptor_t *descriptors, size_t card,
+                     Clock::time_point begin, const std::atomic<bool> &stop)
+{
+    uint8_t chunk[kChunkBytes];
+    uint64_t bytes = 0U;
+    unsigned round = 0U;
+
+    std::memset(chunk, static_cast<int>(card), sizeof(chunk));
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        const size_t phase =
+            static_cast<size_t>((Clock::now() - begin) / kPhase);
+        const size_t hot = phase % XR17V358_UART_CHANNEL_COUNT;
+
+        for (size_t channel = 0U; channel < XR17V358_UART_CHANNEL_COUNT;
+             ++channel)
+        {
+            const size_t port = card * XR17V358_UART_CHANNEL_COUNT + channel;
+            size_t written = 0U;
+
+            if (channel == hot)
+            {
+                (void)serial_driver_write(descriptors[port], chunk,
+                                          sizeof(chunk), &written);
+            }
+            else if (round % kColdEvery == 0U)
+            {
+                (void)serial_driver_write(descriptors[port], chunk, 1U,
+                                          &written);
+            }
+            bytes += written;
+        }
+        round += 1U;
+        std::this_thread::yield();
+    }
+
+    return bytes;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned long run_ms = 300UL;
+    serial_descriptor_t descriptors[UART_DEVICE_COUNT] = {};
+
+    if (argc > 1)
+    {
+        run_ms = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    if (serial_driver_hw_set_mapper(BenchMapper) != UART_ERROR_NONE)
+    {
+        std::fprintf(stderr, "Failed to install benchmark mapper.\n");
+        return 1;
+    }
+
+    for (size_t port = 0U; port < UART_DEVICE_COUNT; ++port)
+    {
+        descriptors[port] = serial_port_init(static_cast<serial_ports_t>(port),
+                                             UART_PORT_MODE_SERIAL);
+        if (descriptors[port] == SERIAL_DESCRIPTOR_INVALID ||
+            serial_driver_set_data_path(descriptors[port],
+                                        SERIAL_DATA_PATH_MMIO_BURST) !=
+                SERIAL_DRIVER_OK)
+        {
+            std::fprintf(stderr, "Failed to initialize port %zu.\n", port);
+            return 1;
+        }
+    }
+
+    std::printf("%zu ports on %zu cards, hot channel moves every %lld ms\n",
+                static_cast<size_t>(UART_DEVICE_COUNT), kCards,
+                static_cast<long long>(kPhase.count()));
+    std::printf("%7s %9s %12s %10s\n", "workers", "mode", "MB/s", "steals");
+    for (size_t workers = 1U; workers <= XR17V358_UART_CHANNEL_COUNT;
+         workers *= 2U)
+    {
+        for (int partition = 0; partition < 2; ++partition)
+        {
+            serial_pool_config_t config = {};
+            std::atomic<bool> stop{false};
+            std::vector<uint64_t> bytes(kCards, 0U);
+            std::vector<std::thread> producers;
+            uint64_t steals = 0U;
+            uint64_t total = 0U;
+
+            config.worker_count = workers;
+            config.static_partition = (partition != 0);
+            config.backoff.spin_passes = 1024U;
+            config.backoff.pause_passes = 4096U;
+            config.backoff.yield_passes = 256U;
+            config.backoff.sleep_us = 100U;
+            if (serial_driver_start_pool(&config) != SERIAL_DRIVER_OK)
+            {
+                std::fprintf(stderr, "Failed to start %zu workers.\n",
+                             workers);
+                return 1;
+            }
+
+            const Clock::time_point begin = Clock::now();
+            for (size_t card = 0U; card < kCards; ++card)
+            {
+                producers.emplace_back([&, card] {
+                    bytes[card] = RunProducer(descriptors, card, begin, stop);
+                });
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(run_ms));
+            stop = true;
+            for (std::thread &producer : producers)
+            {
+                producer.join();
+            }
+            const double seconds =
+                std::chrono::duration<double>(Clock::now() - begin).count();
+
+            for (size_t worker = 0U; worker < workers; ++worker)
+            {
+                serial_poller_stats_t stats = {};
+
+                (void)serial_driver_get_pool_stats(worker, &stats);
+                steals += stats.steals;
+            }
+            (void)serial_driver_stop_pool();
+            for (const uint64_t card_bytes : bytes)
+            {
+                total += card_bytes;
+            }
+
+            std::printf("%7zu %9s %12.2f %10llu\n", workers,
+                        config.static_partition ? "static" : "stealing",
+                        static_cast<double>(total) / seconds / 1.0e6,
+                        static_cast<unsigned long long>(steals));
+        }
+    }
+
+    serial_driver_hw_reset_mapper();
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Per-port scaling benchmark.
+ *
+ * Runs 1..UART_DEVICE_COUNT threads, each pinned to its own port, doing a
+ * full write -> poll TX -> (UART) -> poll RX -> read cycle on that port only.
+ * Ports share no state, so per-port throughput should stay flat as threads
+ * are added; a drop points at false sharing between per-port structures
+ * (descriptor entries, device slots, FIFOs, queues) or at running out of
+ * cores.
+ *
+ * Usage: device_driver_bench_port_scaling [milliseconds_per_run]
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include "device_driver/device_driver.h"
+#include "device_driver/hw_abstraction.h"
+}
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kChunkBytes = 128U;
+
+xr17c358_channel_register_map_t g_registers[UART_DEVICE_COUNT];
+
+uart_error_t BenchMapper(size_t port_index, uart_device_t *uart_device,
+                         uart_device_info_t *device_info)
+{
+    if (uart_device == nullptr || device_info == nullptr ||
+        port_index >= UART_DEVICE_COUNT)
+    {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    uart_device->registers = &g_registers[port_index];
+    device_info->uart_base_address =
+        reinterpret_cast<uintptr_t>(&g_registers[port_index]);
+    device_info->device_name = "bench-uart";
+    return UART_ERROR_NONE;
+}
+
+/* Stand-in for the UART: loop the write FIFO straight into the read FIFO. */
+void LoopWriteToRead(size_t port_index)
+{
+    uart_byte_fifo_t *write_fifo = &uart_fifo_map.write_fifos[port_index];
+    uart_byte_fifo_t *read_fifo = &uart_fifo_map.read_fifos[port_index];
+
+    while (write_fifo->count > 0U &&
+           read_fifo->count < UART_DEVICE_FIFO_SIZE_BYTES)
+    {
+        read_fifo->data[read_fifo->head] = write_fifo->data[write_fifo->tail];
+        read_fifo->head = static_cast<uint16_t>((read_fifo->head + 1U) %
+                                                UART_DEVICE_FIFO_SIZE_BYTES);
+        write_fifo->tail = static_cast<uint16_t>((write_fifo->tail + 1U) %
+                                                 UART_DEVICE_FIFO_SIZE_BYTES);
+        read_fifo->count += 1U;
+        write_fifo->count -= 1U;
+    }
+}
+
+uint64_t RunPort(serial_descriptor_t descriptor, size_t port_index,
+                 const std::atomic<bool> &go, const std::atomic<bool> &stop)
+{
+    uint8_t out[kChunkBytes];
+    uint8_t in[kChunkBytes];
+    uint64_t bytes = 0U;
+
+    std::memset(out, static_cast<int>(port_index), sizeof(out));
+    while (!go.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        size_t written = 0U;
+        size_t tx_bytes = 0U;
+        size_t rx_bytes = 0U;
+        size_t read = 0U;
+
+        (void)serial_driver_write(descriptor, out, sizeof(out), &written);
+        (void)serial_driver_poll(descriptor, sizeof(out), 0U, &tx_bytes,
+                                 &rx_bytes);
+        LoopWriteToRead(port_index);
+        (void)serial_driver_poll(descriptor, 0U, sizeof(in), &tx_bytes,
+                                 &rx_bytes);
+        (void)serial_driver_read(descriptor, in, sizeof(in), &read);
+        bytes += read;
+    }
+
+    return bytes;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned long run_ms = 500UL;
+    serial_descriptor_t descriptors[UART_DEVICE_COUNT] = {};
+
+    if (argc > 1)
+    {
+        run_ms = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    if (serial_driver_hw_set_mapper(BenchMapper) != UART_ERROR_NONE)
+    {
+        std::fprintf(stderr, "Failed to install benchmark mapper.\n");
+        return 1;
+    }
+
+    for (size_t port = 0U; port < UART_DEVICE_COUNT; ++port)
+    {
+        descriptors[port] = serial_port_init(static_cast<serial_ports_t>(port),
+                                             UART_PORT_MODE_SERIAL);
+        if (descriptors[port] == SERIAL_DESCRIPTOR_INVALID)
+        {
+            std::fprintf(stderr, "Failed to initialize port %zu.\n", port);
+            return 1;
+        }
+    }
+
+    std::printf("%7s %14s %14s %14s\n", "threads", "MB/s/port(avg)",
+                "MB/s/port(min)", "MB/s(total)");
+    for (size_t threads = 1U; threads <= UART_DEVICE_COUNT; threads *= 2U)
+    {
+        std::atomic<bool> go{false};
+        std::atomic<bool> stop{false};
+        std::vector<uint64_t> bytes(threads, 0U);
+        std::vector<std::thread> workers;
+
+        for (size_t port = 0U; port < threads; ++port)
+        {
+            workers.emplace_back([&, port] {
+                bytes[port] = RunPort(descriptors[port], port, go, stop);
+            });
+        }
+
+        const Clock::time_point begin = Clock::now();
+        go.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(std::chrono::milliseconds(run_ms));
+        stop = true;
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+        const double seconds =
+            std::chrono::duration<double>(Clock::now() - begin).count();
+
+        uint64_t total = 0U;
+        uint64_t slowest = bytes[0];
+        for (const uint64_t port_bytes : bytes)
+        {
+            total += port_bytes;
+            slowest = std::min(slowest, port_bytes);
+        }
+        std::printf("%7zu %14.2f %14.2f %14.2f\n", threads,
+                    static_cast<double>(total) / threads / seconds / 1.0e6,
+                    static_cast<double>(slowest) / seconds / 1.0e6,
+                    static_cast<double>(total) / seconds / 1.0e6);
+    }
+
+    serial_driver_hw_reset_mapper();
+    return 0;
+}
@@ -4,6 +4,26 @@
 /**
  * @file device_driver.h
  * @brief Public API for the software serial TX queue.
+ *
+ * Per descriptor, @ref serial_driver_write (TX producer),
+ * @ref serial_driver_poll (TX consumer / RX producer) and
+ * @ref serial_driver_read (RX consumer) may each run on their own thread
+ * without locking. Two threads must not call the same one of these
+ * concurrently.
+ *
+ * Build-time configuration (define before including, or on the compiler
+ * command line):
+ * - @c UART_DEVICE_COUNT: device slots, 8 per XR17V358 card (default 8).
+ * - @c UART_SERIAL_QUEUE_POOL_SIZE: TX/RX queue control-block pairs
+ *   available to serial-mode ports (default @c UART_DEVICE_COUNT, 384 bytes
+ *   each). Further serial opens return @ref SERIAL_DESCRIPTOR_INVALID.
+ * - @c UART_QUEUE_ARENA_BYTES: storage for rings opened without caller
+ *   storage (default two 1216-byte rings per pool pair). Discrete ports and
+ *   caller-storage rings take none of it; size it to the serial ports that
+ *   use built-in rings, or 0 if all of them supply storage. Opens that
+ *   exhaust it return @ref SERIAL_DESCRIPTOR_INVALID.
+ * - @c SERIAL_DRIVER_UART_CLOCK_HZ, @c SERIAL_DRIVER_BLOCKING and
+ *   @c SERIAL_DRIVER_EVENTFD: see their definitions below.
  */
 
 #include <stddef.h>
@@ -46,10 +66,18 @@ extern "C"
         SERIAL_DRIVER_ERROR_RX_EMPTY = UART_ERROR_FIFO_QUEUE_EMPTY,
         /** Invalid serial port. */
         SERIAL_DRIVER_ERROR_INVALID_PORT = UART_ERROR_INVALID_ARG,
+        /** Deadline passed before data or space became available. */
+        SERIAL_DRIVER_ERROR_TIMEOUT = UART_ERROR_TIMEOUT,
     } serial_driver_error_t;
 
     /**
      * @brief UART port identifiers for serial descriptor allocation.
+     *
+     * Port n is channel n % 8 of card n / 8. One block of eight names is
+     * generated per card that @c UART_DEVICE_COUNT covers, so multi-card
+     * builds name every port; on a partly populated last card the names
+     * past @ref SERIAL_PORT_COUNT exist but are rejected by
+     * @ref serial_port_init.
      */
     typedef enum SERIAL_PORTS
     {
@@ -61,8 +89,371 @@ extern "C"
         SERIAL_PORT_5,
         SERIAL_PORT_6,
         SERIAL_PORT_7,
+#if UART_DEVICE_COUNT > 8
+        SERIAL_PORT_8,
+        SERIAL_PORT_9,
+        SERIAL_PORT_10,
+        SERIAL_PORT_11,
+        SERIAL_PORT_12,
+        SERIAL_PORT_13,
+        SERIAL_PORT_14,
+        SERIAL_PORT_15,
+#endif
+#if UART_DEVICE_COUNT > 16
+        SERIAL_PORT_16,
+        SERIAL_PORT_17,
+        SERIAL_PORT_18,
+        SERIAL_PORT_19,
+        SERIAL_PORT_20,
+        SERIAL_PORT_21,
+        SERIAL_PORT_22,
+        SERIAL_PORT_23,
+#endif
+#if UART_DEVICE_COUNT > 24
+        SERIAL_PORT_24,
+        SERIAL_PORT_25,
+        SERIAL_PORT_26,
+        SERIAL_PORT_27,
+        SERIAL_PORT_28,
+        SERIAL_PORT_29,
+        SERIAL_PORT_30,
+        SERIAL_PORT_31,
+#endif
+        /** Number of port slots (@c UART_DEVICE_COUNT); not a valid port. */
+        SERIAL_PORT_COUNT = UART_DEVICE_COUNT
     } serial_ports_t;
 
+    /**
+     * @brief Producer model used by @ref serial_driver_write on a descriptor.
+     */
+    typedef enum SERIAL_WRITE_MODE
+    {
+        /** One writer thread; writes may be partially accepted. */
+        SERIAL_WRITE_MODE_SINGLE_PRODUCER = 0,
+        /**
+         * Many writer threads; each write is queued contiguously and whole,
+         * or not at all.
+         */
+        SERIAL_WRITE_MODE_MULTI_PRODUCER
+    } serial_write_mode_t;
+
+    /**
+     * @brief Per-port options for @ref serial_port_init_ex.
+     *
+     * Zero-initialize and set only what differs from @ref serial_port_init.
+     * TX and RX rings are sized independently. With NULL storage a ring of
+     * up to @ref SERIAL_QUEUE_FIXED_SIZE_BYTES (0 selects that default) is
+     * carved from the driver's ring arena. Caller storage lifts that limit,
+     * takes nothing from the arena and must outlive the port.
+     * Power-of-two capacities index with a mask.
+     */
+    typedef struct SerialPortConfig
+    {
+        /** Configuration mode for this UART (serial or discrete). */
+        uart_port_mode_t mode;
+        /** TX ring capacity in bytes (serial mode only). */
+        size_t tx_capacity;
+        /** Optional TX ring storage of @ref tx_capacity bytes, or NULL. */
+        uint8_t *tx_storage;
+        /** RX ring capacity in bytes (serial mode only). */
+        size_t rx_capacity;
+        /** Optional RX ring storage of @ref rx_capacity bytes, or NULL. */
+        uint8_t *rx_storage;
+    } serial_port_config_t;
+
+    /**
+     * @brief How a poll divides one call between TX and RX on a port.
+     */
+    typedef enum SERIAL_POLL_POLICY
+    {
+        /** Drain TX first; service RX only once the TX queue is empty. */
+        SERIAL_POLL_POLICY_TX_FIRST = 0,
+        /** Service both every call, alternating which side goes first. */
+        SERIAL_POLL_POLICY_ALTERNATE,
+        /** Service both every call, RX first. */
+        SERIAL_POLL_POLICY_RX_PRIORITY
+    } serial_poll_policy_t;
+
+    /**
+     * @brief Where a serial port's poll moves bytes to and from.
+     */
+    typedef enum SERIAL_DATA_PATH
+    {
+        /** Software write/read FIFOs in @ref uart_fifo_map. */
+        SERIAL_DATA_PATH_SOFTWARE_FIFO = 0,
+        /**
+         * XR17V358 direct FIFO window (channel offset 0x100). TXCNT/RXCNT are
+         * read once per poll and up to @ref XR17V358_FIFO_DEPTH bytes move as
+         * one burst of 32-bit accesses. Needs EFR[4] clear so offsets
+         * 0x0A/0x0B read as counters rather than trigger levels.
+         */
+        SERIAL_DATA_PATH_MMIO_BURST,
+        /**
+         * As @ref SERIAL_DATA_PATH_MMIO_BURST, but RX reads the FIFO
+         * data-with-status window (channel offset 0x200) so every received
+         * byte comes with its LSR status. Errored bytes are logged for
+         * @ref serial_driver_read_rx_errors; the data itself is queued as
+         * usual.
+         */
+        SERIAL_DATA_PATH_MMIO_BURST_WITH_STATUS
+    } serial_data_path_t;
+
+    /**
+     * @brief Named FIFO trigger/poll-budget presets for
+     * @ref serial_driver_apply_fifo_profile.
+     */
+    typedef enum SERIAL_FIFO_PROFILE
+    {
+        /**
+         * RX trigger 8, TX trigger 128, poll budgets 64/64: bytes reach the
+         * reader quickly and no port holds the poller for long.
+         */
+        SERIAL_FIFO_PROFILE_LATENCY = 0,
+        /**
+         * RX trigger 224, TX trigger 32, poll budgets of a full FIFO: few
+         * service events, each moving close to a FIFO's worth of data.
+         */
+        SERIAL_FIFO_PROFILE_THROUGHPUT
+    } serial_fifo_profile_t;
+
+    /**
+     * @brief Flow-control modes for @ref serial_driver_set_flow_control.
+     */
+    typedef enum SERIAL_FLOW_CONTROL
+    {
+        /** No flow control; RTS is left asserted. */
+        SERIAL_FLOW_CONTROL_NONE = 0,
+        /**
+         * XR17V358 auto RTS/CTS (EFR[7:6]): the UART drops RTS as its RX
+         * FIFO fills and holds TX while CTS is deasserted. The driver only
+         * drains the FIFO into free RX queue space, so a full queue backs up
+         * into the FIFO and from there onto RTS.
+         */
+        SERIAL_FLOW_CONTROL_HW_RTS_CTS,
+        /**
+         * XR17V358 in-band XON1/XOFF1 handling (EFR[3:0]), both ways. UARTs
+         * without it use @ref SERIAL_FLOW_CONTROL_SW_XON_XOFF.
+         */
+        SERIAL_FLOW_CONTROL_HW_XON_XOFF,
+        /**
+         * Driver-managed RTS/CTS for UARTs without the auto modes: polls
+         * drop RTS (MCR[1]) once the RX queue holds @ref
+         * SerialFlowControlConfig::rts_high_water bytes, raise it again at
+         * @ref SerialFlowControlConfig::rts_low_water, and skip TX while MSR
+         * reports CTS deasserted.
+         */
+        SERIAL_FLOW_CONTROL_SW_RTS_CTS,
+        /**
+         * Driver-managed XON/XOFF for UARTs without the in-band mode: polls
+         * consume received XON/XOFF characters (they never reach the RX
+         * queue) and hold TX from XOFF until XON, and send XOFF once the RX
+         * queue holds @ref SerialFlowControlConfig::rts_high_water bytes and
+         * XON again at @ref SerialFlowControlConfig::rts_low_water. Data
+         * bytes equal to either character cannot be carried.
+         */
+        SERIAL_FLOW_CONTROL_SW_XON_XOFF
+    } serial_flow_control_t;
+
+    /**
+     * @brief Options for @ref serial_driver_set_flow_control.
+     *
+     * Zero-initialize and set only what differs from the defaults.
+     */
+    typedef struct SerialFlowControlConfig
+    {
+        /** Flow-control mode. */
+        serial_flow_control_t mode;
+        /** XON character, or 0 for @ref UART_XON_CHAR (XON/XOFF modes). */
+        uint8_t xon_char;
+        /** XOFF character, or 0 for @ref UART_XOFF_CHAR (XON/XOFF modes). */
+        uint8_t xoff_char;
+        /**
+         * RX queue fill, in bytes, that drops RTS or sends XOFF (software
+         * modes), or 0 for three quarters of the RX ring.
+         */
+        uint32_t rts_high_water;
+        /**
+         * RX queue fill, in bytes, that raises RTS or sends XON again
+         * (software modes), or 0 for a quarter of the RX ring. Must be below
+         * the high mark.
+         */
+        uint32_t rts_low_water;
+    } serial_flow_control_config_t;
+
+/**
+ * UART reference clock in Hz that @ref serial_port_configure divides down.
+ * Common XR17V358 clocks are 14745600, 24000000, 62500000 and 125000000;
+ * the divisor table is generated for this value at compile time.
+ */
+#ifndef SERIAL_DRIVER_UART_CLOCK_HZ
+#define SERIAL_DRIVER_UART_CLOCK_HZ 125000000UL
+#endif
+
+/**
+ * Non-zero when @ref serial_driver_read_timeout and
+ * @ref serial_driver_write_timeout can park the calling thread (POSIX
+ * threads, monotonic clock). Defaults on for Linux hosts; define it to 0 for
+ * bare-metal builds.
+ */
+#ifndef SERIAL_DRIVER_BLOCKING
+#if defined(__linux__)
+#define SERIAL_DRIVER_BLOCKING 1
+#else
+#define SERIAL_DRIVER_BLOCKING 0
+#endif
+#endif
+
+/**
+ * Non-zero when @ref serial_driver_open_event_fd can hand out a Linux
+ * eventfd. Defaults on for Linux hosts.
+ */
+#ifndef SERIAL_DRIVER_EVENTFD
+#if defined(__linux__)
+#define SERIAL_DRIVER_EVENTFD 1
+#else
+#define SERIAL_DRIVER_EVENTFD 0
+#endif
+#endif
+
+    /**
+     * @brief Readiness bits returned by @ref serial_driver_ack_event_fd.
+     */
+    typedef enum
+    {
+        /** RX queue holds at least the configured threshold. */
+        SERIAL_EVENT_RX_READY = 1U << 0,
+        /** TX queue is at or below the configured low-water mark. */
+        SERIAL_EVENT_TX_READY = 1U << 1
+    } serial_event_t;
+
+    /**
+     * @brief Readiness levels for a port's event file descriptor.
+     */
+    typedef struct SerialEventConfig
+    {
+        /** RX queue fill, in bytes, that signals; 0 behaves as 1. */
+        size_t rx_threshold;
+        /** TX queue fill, in bytes, at or below which a drain signals. */
+        size_t tx_low_water;
+    } serial_event_config_t;
+
+    /**
+     * @brief Settings for the driver-owned poller thread.
+     *
+     * After a pass that moves no bytes the thread backs off in stages,
+     * counted in consecutive idle passes: busy-poll for @ref spin_passes,
+     * then a CPU pause per pass for @ref pause_passes, then
+     * `sched_yield()` for @ref yield_passes, then sleep @ref sleep_us
+     * between passes. Any pass that moves bytes returns it to busy-polling.
+     */
+    typedef struct SerialPollerConfig
+    {
+        /** CPU to pin the thread to, or -1 to leave it unpinned. */
+        int cpu;
+        /** Idle passes spent busy-polling. */
+        uint32_t spin_passes;
+        /** Idle passes spent with a CPU pause after the spin stage. */
+        uint32_t pause_passes;
+        /** Idle passes spent yielding after the pause stage. */
+        uint32_t yield_passes;
+        /** Sleep per idle pass after the yield stage, in microseconds;
+         * 0 keeps yielding. */
+        uint32_t sleep_us;
+    } serial_poller_config_t;
+
+    /**
+     * @brief Poller thread or pool worker counters since its last start.
+     */
+    typedef struct SerialPollerStats
+    {
+        /** Passes over the open serial ports. */
+        uint64_t passes;
+        /** Passes that moved at least one byte. */
+        uint64_t busy_passes;
+        /** Idle passes that paused the CPU. */
+        uint64_t pauses;
+        /** Idle passes that yielded. */
+        uint64_t yields;
+        /** Idle passes that slept. */
+        uint64_t sleeps;
+        /** Services of another worker's port that moved bytes (pool only). */
+        uint64_t steals;
+        /** Port services that returned an error. */
+        uint64_t errors;
+        /** Status of the most recent failed service, or
+         * @ref SERIAL_DRIVER_OK. */
+        serial_driver_error_t last_error;
+    } serial_poller_stats_t;
+
+/** Largest worker count @ref serial_driver_start_pool accepts. */
+#define SERIAL_POOL_MAX_WORKERS UART_DEVICE_COUNT
+
+    /**
+     * @brief Settings for the work-stealing service pool.
+     */
+    typedef struct SerialPoolConfig
+    {
+        /** Worker threads, 1 to @ref SERIAL_POOL_MAX_WORKERS. */
+        size_t worker_count;
+        /** CPU per worker (@ref worker_count entries, -1 for unpinned), or
+         * NULL to leave every worker unpinned. */
+        const int *worker_cpus;
+        /** Only service home ports; for comparison with stealing. */
+        bool static_partition;
+        /** Idle backoff of each worker; the cpu field is ignored. */
+        serial_poller_config_t backoff;
+    } serial_pool_config_t;
+
+    /**
+     * @brief Parity settings for @ref serial_port_configure.
+     */
+    typedef enum SERIAL_PARITY
+    {
+        SERIAL_PARITY_NONE = 0,
+        SERIAL_PARITY_ODD,
+        SERIAL_PARITY_EVEN,
+        /** Parity bit always 1. */
+        SERIAL_PARITY_MARK,
+        /** Parity bit always 0. */
+        SERIAL_PARITY_SPACE
+    } serial_parity_t;
+
+    /**
+     * @brief Stop-bit settings for @ref serial_port_configure.
+     */
+    typedef enum SERIAL_STOP_BITS
+    {
+        SERIAL_STOP_BITS_1 = 1,
+        /** Two stop bits (1.5 with 5 data bits). */
+        SERIAL_STOP_BITS_2 = 2
+    } serial_stop_bits_t;
+
+/** Errors kept per port for @ref serial_driver_read_rx_errors. */
+#ifndef SERIAL_RX_ERROR_LOG_DEPTH
+#define SERIAL_RX_ERROR_LOG_DEPTH 16U
+#endif
+
+    /**
+     * @brief One errored receive byte.
+     */
+    typedef struct SerialRxError
+    {
+        /**
+         * Offset of the byte in the port's RX stream, counted from 0. Errors
+         * taken from the channel LSR by @ref serial_driver_handle_interrupt
+         * carry the offset of the next byte to be polled instead.
+         */
+        uint64_t offset;
+        /**
+         * @ref UART_ERROR_OVERRUN, @ref UART_ERROR_PARITY or
+         * @ref UART_ERROR_FRAMING (also used for a break), in that order of
+         * precedence when several bits are set.
+         */
+        uart_error_t error;
+        /** Raw LSR status byte reported with the data byte. */
+        uint8_t lsr;
+    } serial_rx_error_t;
+
     /**
      * @brief Initialize one UART port instance and return its descriptor.
      *
@@ -74,6 +465,20 @@ extern "C"
     serial_descriptor_t serial_port_init(serial_ports_t port,
                                          uart_port_mode_t mode);
 
+    /**
+     * @brief Initialize one UART port with explicit ring sizing/storage.
+     *
+     * If @p port is already initialized its existing descriptor is returned
+     * and @p config is ignored.
+     *
+     * @param port UART port used to resolve the device from @ref uart_devices.
+     * @param config Port options; see @ref serial_port_config_t.
+     * @return Valid serial descriptor on success, @ref
+     * SERIAL_DESCRIPTOR_INVALID on failure (including invalid ring sizes).
+     */
+    serial_descriptor_t serial_port_init_ex(serial_ports_t port,
+                                            const serial_port_config_t *config);
+
     /**
      * @brief Queue transmit bytes from a user buffer.
      *
@@ -91,6 +496,105 @@ extern "C"
                                               size_t length,
                                               size_t *out_bytes_written);
 
+    /**
+     * @brief Select the producer model for @ref serial_driver_write.
+     *
+     * In @ref SERIAL_WRITE_MODE_MULTI_PRODUCER any number of threads may call
+     * @ref serial_driver_write on the descriptor concurrently. Each call
+     * reserves space in the TX ring atomically and commits in reservation
+     * order, so its bytes stay contiguous on the wire; a call that does not
+     * fit returns @ref SERIAL_DRIVER_ERROR_TX_FULL with nothing written.
+     * Switch modes only while no writer is active.
+     *
+     * @param descriptor Serial descriptor.
+     * @param mode Producer model to use.
+     * @return @ref SERIAL_DRIVER_OK on success, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_set_write_mode(serial_descriptor_t descriptor,
+                                 serial_write_mode_t mode);
+
+    /**
+     * @brief Expose free TX ring space for in-place encoding.
+     *
+     * Returns all free TX space as up to two spans; @p out_second is non-empty
+     * only when the free region wraps past the end of the ring. Write frames
+     * directly into the spans, first span first, then publish them with
+     * @ref serial_driver_write_commit. Only valid in
+     * @ref SERIAL_WRITE_MODE_SINGLE_PRODUCER, on the writer thread.
+     *
+     * @param descriptor Serial descriptor.
+     * @param min_length Minimum contiguous-or-wrapped free bytes required.
+     * @param out_first Output first writable span.
+     * @param out_second Output writable span after the wrap point.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_TX_FULL when fewer than @p min_length bytes
+     * are free, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_write_reserve(serial_descriptor_t descriptor,
+                                size_t min_length, serial_span_t *out_first,
+                                serial_span_t *out_second);
+
+    /**
+     * @brief Queue @p length bytes written through
+     * @ref serial_driver_write_reserve for transmission.
+     *
+     * @param descriptor Serial descriptor.
+     * @param length Bytes to publish, counted from the start of the first span.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_INVALID_ARG when @p length exceeds the free
+     * space, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_write_commit(serial_descriptor_t descriptor, size_t length);
+
+    /**
+     * @brief Queue several buffers as one contiguous write.
+     *
+     * Each segment is copied straight into the TX ring after one descriptor
+     * check and one space check, so a header, payload and trailer need
+     * neither three calls nor a staging copy. All-or-nothing: if the ring
+     * cannot take the total nothing is queued. Only valid in
+     * @ref SERIAL_WRITE_MODE_SINGLE_PRODUCER.
+     *
+     * @param descriptor Serial descriptor.
+     * @param iov Segments to send, in order.
+     * @param iovcnt Number of entries in @p iov.
+     * @param out_bytes_written Output number of bytes queued (0 or the
+     * total).
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_TX_FULL when the total does not fit,
+     * otherwise an error code.
+     */
+    serial_driver_error_t serial_driver_writev(serial_descriptor_t descriptor,
+                                               const serial_const_span_t *iov,
+                                               size_t iovcnt,
+                                               size_t *out_bytes_written);
+
+    /**
+     * @brief Write a user buffer, waiting for TX ring space.
+     *
+     * Queues what fits, then parks the calling thread until a poll of this
+     * port frees space, repeating until all of @p data is queued or
+     * @p timeout_ms passes. Another thread must be polling the port. In
+     * @ref SERIAL_WRITE_MODE_MULTI_PRODUCER each attempt is all-or-nothing.
+     *
+     * @param descriptor Serial descriptor.
+     * @param data Input bytes.
+     * @param length Number of bytes to write.
+     * @param out_bytes_written Output number of bytes queued.
+     * @param timeout_ms Longest time to wait, in milliseconds; 0 only tries.
+     * @return @ref SERIAL_DRIVER_OK when everything was queued,
+     * @ref SERIAL_DRIVER_ERROR_TIMEOUT on expiry (with a partial count),
+     * @ref SERIAL_DRIVER_ERROR_NOT_CONFIGURED without
+     * @ref SERIAL_DRIVER_BLOCKING, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_write_timeout(serial_descriptor_t descriptor,
+                                const uint8_t *data, size_t length,
+                                size_t *out_bytes_written, uint32_t timeout_ms);
+
     /**
      * @brief Read received bytes into a user buffer.
      *
@@ -104,6 +608,80 @@ extern "C"
                                              uint8_t *data, size_t length,
                                              size_t *out_bytes_read);
 
+    /**
+     * @brief Expose received bytes in place without copying them out.
+     *
+     * Returns the readable RX bytes in order as up to two read-only spans;
+     * @p out_second is non-empty only when the data wraps past the end of the
+     * ring. Spans stay valid until the bytes are released with
+     * @ref serial_driver_read_consume. Call from the reader thread only.
+     *
+     * @param descriptor Serial descriptor.
+     * @param out_first Output first readable span.
+     * @param out_second Output readable span after the wrap point.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_RX_EMPTY when nothing is readable, otherwise
+     * an error code.
+     */
+    serial_driver_error_t
+    serial_driver_read_peek(serial_descriptor_t descriptor,
+                            serial_const_span_t *out_first,
+                            serial_const_span_t *out_second);
+
+    /**
+     * @brief Release @p length bytes returned by @ref serial_driver_read_peek.
+     *
+     * @param descriptor Serial descriptor.
+     * @param length Bytes to release, counted from the start of the first span.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_INVALID_ARG when @p length exceeds the
+     * readable bytes, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_read_consume(serial_descriptor_t descriptor, size_t length);
+
+    /**
+     * @brief Read received bytes across several buffers.
+     *
+     * Fills the segments in order straight from the RX ring, as many bytes
+     * as are readable and fit.
+     *
+     * @param descriptor Serial descriptor.
+     * @param iov Segments to fill, in order.
+     * @param iovcnt Number of entries in @p iov.
+     * @param out_bytes_read Output number of bytes read.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_RX_EMPTY when nothing is readable, otherwise
+     * an error code.
+     */
+    serial_driver_error_t serial_driver_readv(serial_descriptor_t descriptor,
+                                              const serial_span_t *iov,
+                                              size_t iovcnt,
+                                              size_t *out_bytes_read);
+
+    /**
+     * @brief Read received bytes, waiting for data.
+     *
+     * Returns as soon as at least one byte is readable, like POSIX
+     * `read()`. The calling thread is parked until a poll of this port
+     * receives data or @p timeout_ms passes; another thread must be polling
+     * the port.
+     *
+     * @param descriptor Serial descriptor.
+     * @param data Output buffer.
+     * @param length Output buffer length in bytes.
+     * @param out_bytes_read Output number of bytes read.
+     * @param timeout_ms Longest time to wait, in milliseconds; 0 only tries.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_TIMEOUT when nothing arrived in time,
+     * @ref SERIAL_DRIVER_ERROR_NOT_CONFIGURED without
+     * @ref SERIAL_DRIVER_BLOCKING, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_read_timeout(serial_descriptor_t descriptor, uint8_t *data,
+                               size_t length, size_t *out_bytes_read,
+                               uint32_t timeout_ms);
+
     /**
      * @brief Enable UART local loopback for a serial descriptor.
      *
@@ -143,7 +721,10 @@ extern "C"
     serial_driver_disable_discrete(serial_descriptor_t descriptor);
 
     /**
-     * @brief Poll one serial port: drain TX first, then service RX.
+     * @brief Poll one serial port under its @ref serial_poll_policy_t.
+     *
+     * With the default @ref SERIAL_POLL_POLICY_TX_FIRST, TX is drained first
+     * and RX is serviced only once no TX data remains queued.
      *
      * @param descriptor Serial descriptor.
      * @param max_tx_bytes Maximum TX bytes to write this call.
@@ -158,6 +739,402 @@ extern "C"
                                              size_t *out_tx_bytes_transmitted,
                                              size_t *out_rx_bytes_received);
 
+    /**
+     * @brief Per-port outcome of @ref serial_driver_poll_all.
+     */
+    typedef struct SerialPollResult
+    {
+        /** Descriptor of the serviced port. */
+        serial_descriptor_t descriptor;
+        /** TX bytes moved into the device FIFO. */
+        size_t tx_bytes;
+        /** RX bytes moved out of the device FIFO. */
+        size_t rx_bytes;
+        /** Result of servicing this port. */
+        serial_driver_error_t status;
+    } serial_poll_result_t;
+
+    /**
+     * @brief Select how @ref serial_driver_poll and
+     * @ref serial_driver_poll_all share a call between TX and RX.
+     *
+     * The full-duplex policies keep RX moving while TX is saturated, so the
+     * device read FIFO cannot overflow behind a long transmit.
+     *
+     * @param descriptor Serial descriptor.
+     * @param policy Fairness policy to use.
+     * @return @ref SERIAL_DRIVER_OK on success, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_set_poll_policy(serial_descriptor_t descriptor,
+                                  serial_poll_policy_t policy);
+
+    /**
+     * @brief Set the per-call byte budgets @ref serial_driver_poll_all uses
+     * for one port.
+     *
+     * New serial ports default to @ref UART_DEVICE_FIFO_SIZE_BYTES each way.
+     *
+     * @param descriptor Serial descriptor.
+     * @param max_tx_bytes TX bytes moved per poll, at most.
+     * @param max_rx_bytes RX bytes moved per poll, at most.
+     * @return @ref SERIAL_DRIVER_OK on success, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_set_poll_budget(serial_descriptor_t descriptor,
+                                  size_t max_tx_bytes, size_t max_rx_bytes);
+
+    /**
+     * @brief Select the data path polls use for one serial port.
+     *
+     * New serial ports use @ref SERIAL_DATA_PATH_SOFTWARE_FIFO. Change the
+     * path only while no poll is running on the port.
+     *
+     * @param descriptor Serial descriptor.
+     * @param path Data path to use.
+     * @return @ref SERIAL_DRIVER_OK on success, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_set_data_path(serial_descriptor_t descriptor,
+                                serial_data_path_t path);
+
+    /**
+     * @brief Program a port's TX and RX FIFO trigger levels.
+     *
+     * Selects trigger table D in FCTR and writes TXTRG/RXTRG, setting
+     * EFR[4] only for the duration of the update. The RX interrupt fires
+     * once @p rx_trigger bytes are waiting; the TX interrupt fires when the
+     * TX FIFO drains to @p tx_trigger bytes. Higher RX and lower TX levels
+     * mean fewer service events per byte at the cost of latency.
+     *
+     * @param descriptor Serial descriptor.
+     * @param tx_trigger TX FIFO level, in bytes, that raises TX empty.
+     * @param rx_trigger RX FIFO level, in bytes, that raises RX data; 1 to
+     * @ref XR17V358_FIFO_DEPTH - 1.
+     * @return @ref SERIAL_DRIVER_OK on success, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_set_fifo_triggers(serial_descriptor_t descriptor,
+                                    uint8_t tx_trigger, uint8_t rx_trigger);
+
+    /**
+     * @brief Apply a named trigger-level preset and the matching poll
+     * budgets (@ref serial_driver_set_poll_budget) to a port.
+     *
+     * @param descriptor Serial descriptor.
+     * @param profile Preset to apply.
+     * @return @ref SERIAL_DRIVER_OK on success, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_apply_fifo_profile(serial_descriptor_t descriptor,
+                                     serial_fifo_profile_t profile);
+
+    /**
+     * @brief Program a serial port's baud rate and character format.
+     *
+     * The divisor comes from a table built at compile time for
+     * @ref SERIAL_DRIVER_UART_CLOCK_HZ (other rates are computed the same
+     * way on the fly). 16X sampling is used when it gets within 3% of
+     * @p baud; otherwise the port's 8XMODE or 4XMODE bit is set, which is
+     * what reaches the 1.5-8 Mbaud range. Calls that repeat the current
+     * settings touch no registers, and a format-only change rewrites just
+     * LCR, so ports can be retuned at runtime without re-initializing.
+     *
+     * @param descriptor Serial descriptor.
+     * @param baud Baud rate in bits per second.
+     * @param data_bits Data bits per character, 5 to 8.
+     * @param parity Parity setting.
+     * @param stop_bits Stop-bit setting.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_INVALID_ARG for an unsupported setting or a
+     * baud rate the clock cannot reach, otherwise an error code.
+     */
+    serial_driver_error_t serial_port_configure(serial_descriptor_t descriptor,
+                                                uint32_t baud,
+                                                uint8_t data_bits,
+                                                serial_parity_t parity,
+                                                serial_stop_bits_t stop_bits);
+
+    /**
+     * @brief Select a port's flow-control mode.
+     *
+     * Hardware modes program EFR (and XOFF1/XON1 for in-band mode) with
+     * EFR[4] set only for the update; any mode leaves RTS asserted to
+     * start with. Change the mode only while no poll is running on the port.
+     *
+     * Both hardware modes have a software fallback driven by the poll:
+     * @ref SERIAL_FLOW_CONTROL_SW_RTS_CTS and
+     * @ref SERIAL_FLOW_CONTROL_SW_XON_XOFF. Only the latter scans received
+     * bytes, and only for its two characters. The watermarks are validated
+     * only for the software modes and ignored by the others.
+     *
+     * @param descriptor Serial descriptor.
+     * @param config Flow-control options; see @ref
+     * serial_flow_control_config_t.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_INVALID_ARG for an unknown mode or (software
+     * modes only) a low watermark not below the high one, a high watermark
+     * above the RX ring, or equal XON and XOFF characters, otherwise an
+     * error code.
+     */
+    serial_driver_error_t
+    serial_driver_set_flow_control(serial_descriptor_t descriptor,
+                                   const serial_flow_control_config_t *config);
+
+    /**
+     * @brief Take the logged receive errors of one serial port, oldest first.
+     *
+     * Errors are logged from two sources: per byte by
+     * @ref SERIAL_DATA_PATH_MMIO_BURST_WITH_STATUS, and from the channel LSR
+     * when @ref serial_driver_handle_interrupt decodes an RX line-status
+     * interrupt on any other data path. The log holds
+     * @ref SERIAL_RX_ERROR_LOG_DEPTH entries; errors arriving while it is
+     * full are counted, not stored. Call from the thread that polls the
+     * port.
+     *
+     * @param descriptor Serial descriptor.
+     * @param out_errors Output array for the taken entries.
+     * @param capacity Number of entries in @p out_errors.
+     * @param out_count Output number of entries written.
+     * @param out_dropped Output number of errors dropped since the last call.
+     * @return @ref SERIAL_DRIVER_OK on success, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_read_rx_errors(serial_descriptor_t descriptor,
+                                 serial_rx_error_t *out_errors,
+                                 size_t capacity, size_t *out_count,
+                                 uint64_t *out_dropped);
+
+    /**
+     * @brief Flag that a port's device read FIFO has data.
+     *
+     * Call from whatever observes receive activity (interrupt handler, line
+     * status poll) so the next @ref serial_driver_poll_all services the port.
+     *
+     * @param descriptor Serial descriptor.
+     * @return @ref SERIAL_DRIVER_OK on success, otherwise an error code.
+     */
+    serial_driver_error_t serial_driver_notify_rx(serial_descriptor_t descriptor);
+
+    /**
+     * @brief Service every serial port that has pending work.
+     *
+     * Writes mark a port's TX side pending and @ref serial_driver_notify_rx
+     * marks its RX side; ports with neither are skipped without touching
+     * their state. Each pending port is serviced like @ref serial_driver_poll
+     * under its own policy and budget (@ref serial_driver_set_poll_budget), and ports
+     * with work left over stay pending for the next call. Acts as the TX
+     * consumer and RX producer of every port it services, so do not mix it
+     * with concurrent @ref serial_driver_poll calls on the same port.
+     *
+     * @param out_results Output array, one entry per serviced port.
+     * @param result_capacity Number of entries in @p out_results; ports
+     * beyond it stay pending.
+     * @param out_result_count Output number of entries written.
+     * @return @ref SERIAL_DRIVER_OK on success, otherwise an error code.
+     */
+    serial_driver_error_t serial_driver_poll_all(serial_poll_result_t *out_results,
+                                                 size_t result_capacity,
+                                                 size_t *out_result_count);
+
+    /**
+     * @brief Decode the XR17V358 global interrupt registers and queue work
+     * for the channels that raised them.
+     *
+     * INT0 is read once; for each set channel bit the 3-bit source in
+     * INT1-INT3 selects the work: RX data and RX time-out mark the port
+     * RX-pending, TX empty marks it TX-pending, line status also reads the
+     * channel LSR and logs any error for @ref serial_driver_read_rx_errors,
+     * and modem status reads MSR to clear it. Channels without an open
+     * serial port are otherwise ignored. Nothing is moved; follow with
+     * @ref serial_driver_poll_all, or use @ref serial_driver_service_event
+     * which does both.
+     *
+     * Each card has its own global registers and interrupt line: channel
+     * bit n of card @p card is port `card * 8 + n`. Channels without a
+     * device slot (past @ref UART_DEVICE_COUNT) are ignored.
+     *
+     * @param card Card index, 0 for the card holding ports 0-7.
+     * @param device_config That card's global configuration registers
+     * (channel 0 window, offset 0x80).
+     * @param out_channel_mask Output mask of the card's channels that had
+     * an interrupt pending; 0 for an interrupt raised by another device on
+     * a shared line.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_INVALID_ARG for a card with no device slots,
+     * otherwise an error code.
+     */
+    serial_driver_error_t serial_driver_handle_interrupt(
+        size_t card, const xr17v358_device_config_registers_t *device_config,
+        uint32_t *out_channel_mask);
+
+    /**
+     * @brief Service one interrupt event: decode it, then move data for the
+     * ports it flagged.
+     *
+     * Entry point for a host event loop, e.g. Linux UIO: block in read() on
+     * the UIO device, call this, then write 1 to re-enable the interrupt.
+     * Idle channels are never touched, so no core is spent spin-polling.
+     *
+     * @param card Card that raised the interrupt; see
+     * @ref serial_driver_handle_interrupt.
+     * @param device_config That card's global configuration registers.
+     * @param out_results Output array, one entry per serviced port.
+     * @param result_capacity Number of entries in @p out_results.
+     * @param out_result_count Output number of entries written.
+     * @return @ref SERIAL_DRIVER_OK on success, otherwise an error code.
+     */
+    serial_driver_error_t serial_driver_service_event(
+        size_t card, const xr17v358_device_config_registers_t *device_config,
+        serial_poll_result_t *out_results, size_t result_capacity,
+        size_t *out_result_count);
+
+    /**
+     * @brief Get a file descriptor that becomes readable when a port is ready.
+     *
+     * Creates a non-blocking eventfd for the descriptor (or updates the
+     * levels of the existing one) for use with epoll/poll/select. A poll
+     * that receives bytes and leaves the RX queue at or above
+     * @ref SerialEventConfig::rx_threshold, or transmits bytes and leaves
+     * the TX queue at or below @ref SerialEventConfig::tx_low_water, makes
+     * it readable. It is signalled at most once until
+     * @ref serial_driver_ack_event_fd, so a burst costs one wakeup.
+     *
+     * @param descriptor Serial descriptor.
+     * @param config Readiness levels.
+     * @param out_fd Output file descriptor, owned by the driver.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_NOT_CONFIGURED without
+     * @ref SERIAL_DRIVER_EVENTFD or when no eventfd can be created,
+     * otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_open_event_fd(serial_descriptor_t descriptor,
+                                const serial_event_config_t *config,
+                                int *out_fd);
+
+    /**
+     * @brief Acknowledge a port's event file descriptor.
+     *
+     * Call from the event loop when the descriptor is readable: it clears
+     * the eventfd, re-arms signalling and reports which levels currently
+     * hold. Handle every reported condition before waiting again; like
+     * EPOLLET, only new activity signals afterwards.
+     *
+     * @param descriptor Serial descriptor.
+     * @param out_events Output mask of @ref serial_event_t bits.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_NOT_CONFIGURED when no eventfd is open,
+     * otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_ack_event_fd(serial_descriptor_t descriptor,
+                               uint32_t *out_events);
+
+    /**
+     * @brief Close a port's event file descriptor.
+     *
+     * Must not run concurrently with polls of the port.
+     *
+     * @param descriptor Serial descriptor.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_NOT_CONFIGURED when no eventfd is open,
+     * otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_close_event_fd(serial_descriptor_t descriptor);
+
+    /**
+     * @brief Start the driver-owned poller thread.
+     *
+     * The thread repeatedly services every serial port open at the time of
+     * the call, with each port's @ref serial_driver_set_poll_budget budgets,
+     * and backs off as described in @ref SerialPollerConfig. Blocked
+     * readers, writers and event file descriptors are woken from it as
+     * from @ref serial_driver_poll. While it runs, the application must not
+     * poll those ports itself. A port whose service returns an error is
+     * counted in @ref SerialPollerStats::errors and not serviced again until
+     * the thread is restarted. Requires @ref SERIAL_DRIVER_BLOCKING.
+     *
+     * @param config Thread settings, or NULL for defaults (unpinned,
+     * 1024 spin, 4096 pause and 256 yield passes, then 100 us sleeps).
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_INVALID_ARG when the thread cannot be
+     * created or pinned, @ref SERIAL_DRIVER_ERROR_NOT_CONFIGURED when it is
+     * already running or unsupported, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_start_poller(const serial_poller_config_t *config);
+
+    /**
+     * @brief Stop the poller thread and wait for it to exit.
+     *
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_NOT_CONFIGURED when it is not running.
+     */
+    serial_driver_error_t serial_driver_stop_poller(void);
+
+    /**
+     * @brief Read the poller thread counters.
+     *
+     * Counters are zero until the poller has run. Once the engine has run
+     * as a pool (@ref serial_driver_start_pool), read its counters per
+     * worker with @ref serial_driver_get_pool_stats instead.
+     *
+     * @param out_stats Output counters.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_NOT_CONFIGURED when the engine last ran as a
+     * pool or the poller is unsupported, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_get_poller_stats(serial_poller_stats_t *out_stats);
+
+    /**
+     * @brief Start a pool of service threads with work stealing.
+     *
+     * The serial ports open at the time of the call are dealt round-robin
+     * to the workers as home ports, which each worker services on every
+     * pass. A worker whose home ports moved nothing services other
+     * workers' ports that are flagged pending (queued TX, RX notified or
+     * left behind by a budget). A port is only serviced by the worker
+     * holding its atomic claim flag, so ports change hands without locks
+     * and their bytes stay in order. A port whose service returns an error
+     * is counted in the serving worker's @ref SerialPollerStats::errors and
+     * dropped by every worker until the pool is restarted. While the pool
+     * runs, the application must not poll those ports itself, and the poller
+     * thread cannot run. Requires @ref SERIAL_DRIVER_BLOCKING.
+     *
+     * @param config Pool settings.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_INVALID_ARG for a bad config or when a
+     * worker cannot be created or pinned,
+     * @ref SERIAL_DRIVER_ERROR_NOT_CONFIGURED when service threads are
+     * already running or unsupported, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_start_pool(const serial_pool_config_t *config);
+
+    /**
+     * @brief Stop the pool and wait for its workers to exit.
+     *
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_NOT_CONFIGURED when it is not running.
+     */
+    serial_driver_error_t serial_driver_stop_pool(void);
+
+    /**
+     * @brief Read one pool worker's counters.
+     *
+     * @param worker Worker index.
+     * @param out_stats Output counters.
+     * @return @ref SERIAL_DRIVER_OK on success,
+     * @ref SERIAL_DRIVER_ERROR_INVALID_ARG for a worker the last pool did
+     * not have, otherwise an error code.
+     */
+    serial_driver_error_t
+    serial_driver_get_pool_stats(size_t worker,
+                                 serial_poller_stats_t *out_stats);
+
 #ifdef __cplusplus
 }
 #endif
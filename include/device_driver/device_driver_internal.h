@@ -2,6 +2,8 @@
 #define SERIAL_DRIVER_INTERNAL_H
 #include "device_driver/device_driver.h"
 
+#include <string.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -10,28 +12,74 @@ extern "C"
      * Internal helpers were intentionally removed from the exported interface.
      * Use the public API in device_driver.h.
      */
+    /* One cache line per entry so ports polled on different threads never
+     * share one. */
     typedef struct SerialDescriptorEntry
     {
+        SERIAL_QUEUE_ALIGNAS(SERIAL_QUEUE_CACHE_LINE_BYTES)
         uart_device_t *uart_device;
         uint32_t port_index;
         uart_port_mode_t mode;
-        uint32_t tx_input_staged_word;
-        size_t tx_input_staged_word_bytes;
-        uint32_t staged_word;
-        size_t staged_word_bytes;
-        uint32_t rx_staged_word;
-        size_t rx_staged_word_bytes;
-        uint32_t rx_output_staged_word;
-        size_t rx_output_staged_word_bytes;
+        serial_write_mode_t write_mode;
         bool initialized;
+        bool poll_rx_next;
+        /* Software flow control is holding the peer off (RTS low or XOFF
+         * sent). */
+        bool rx_throttled;
+        /* Software XON/XOFF: the peer sent XOFF, so TX is held. */
+        bool tx_xoff_held;
+        size_t poll_tx_budget;
+        size_t poll_rx_budget;
+        serial_poll_policy_t poll_policy;
+        serial_data_path_t data_path;
+        serial_flow_control_t flow_control;
+        uint32_t rts_high_water;
+        uint32_t rts_low_water;
+        uint8_t xon_char;
+        uint8_t xoff_char;
+        /* Software XON/XOFF: the XOFF or XON for rx_throttled is not yet
+         * in the device FIFO. */
+        bool flow_char_pending;
     } serial_descriptor_entry_t;
 
+#ifdef __cplusplus
+    static serial_descriptor_entry_t serial_descriptor_map[UART_DEVICE_COUNT] =
+        {};
+#else
     static serial_descriptor_entry_t serial_descriptor_map[UART_DEVICE_COUNT] =
         {0};
+#endif
     static bool serial_driver_common_initialized = false;
+    /* Pairs in uart_queue_pool handed out so far; ports are never closed. */
+    static size_t serial_queue_pool_used = 0U;
+    /* Bytes of uart_queue_arena handed out so far, for built-in rings. */
+    static size_t serial_queue_arena_used = 0U;
+
+    /* Per-port RX error log, written and drained by the polling thread. */
+    typedef struct SerialRxErrorLog
+    {
+        serial_rx_error_t entries[SERIAL_RX_ERROR_LOG_DEPTH];
+        size_t first;
+        size_t count;
+        /* Bytes received on the port so far; offset of the next one. */
+        uint64_t rx_offset;
+        uint64_t dropped;
+    } serial_rx_error_log_t;
+
+    static serial_rx_error_log_t serial_rx_error_logs[UART_DEVICE_COUNT];
 
-    extern uart_error_t serial_driver_hw_map_uart(size_t port_index,
-                                                  uart_device_t *uart_device);
+    extern uart_error_t
+    serial_driver_hw_map_uart(size_t port_index, uart_device_t *uart_device,
+                              uart_device_info_t *device_info);
+
+    /*
+     * Test-only hook, not part of the public API: close every port and
+     * eventfd and re-run the common init so each test starts from a clean
+     * driver. Refuses with SERIAL_DRIVER_ERROR_NOT_CONFIGURED while the
+     * poller or a pool runs; nothing else may run concurrently. UART
+     * registers and the hardware mapper are left alone.
+     */
+    extern serial_driver_error_t serial_driver_reset(void);
 
     static serial_descriptor_entry_t *
     serial_driver_get_entry(serial_descriptor_t descriptor)
@@ -57,54 +105,146 @@ extern "C"
         return &serial_descriptor_map[index];
     }
 
-    static void serial_driver_byte_fifo_reset(uart_byte_fifo_t *fifo)
+    /*
+     * Store @p length bytes into the device FIFO window starting at window
+     * byte @p offset. Aligned stretches go out as 32-bit stores so a full
+     * FIFO load is 64 bus writes instead of 256.
+     */
+    static void serial_driver_mmio_burst_write(volatile uint8_t *window,
+                                               size_t offset,
+                                               const uint8_t *data,
+                                               size_t length)
     {
-        if (fifo == NULL)
+        uint32_t word = 0U;
+
+        while (length > 0U && ((uintptr_t)&window[offset] & 3U) != 0U)
         {
-            return;
+            window[offset++] = *data++;
+            length -= 1U;
+        }
+        while (length >= sizeof(word))
+        {
+            memcpy(&word, data, sizeof(word));
+            *(volatile uint32_t *)&window[offset] = word;
+            offset += sizeof(word);
+            data += sizeof(word);
+            length -= sizeof(word);
         }
+        while (length > 0U)
+        {
+            window[offset++] = *data++;
+            length -= 1U;
+        }
+    }
 
-        fifo->head = 0U;
-        fifo->tail = 0U;
-        fifo->count = 0U;
+    /*
+     * Load @p length bytes from the device FIFO window starting at window
+     * byte @p offset, using 32-bit reads for aligned stretches.
+     */
+    static void serial_driver_mmio_burst_read(const volatile uint8_t *window,
+                                              size_t offset, uint8_t *data,
+                                              size_t length)
+    {
+        uint32_t word = 0U;
+
+        while (length > 0U && ((uintptr_t)&window[offset] & 3U) != 0U)
+        {
+            *data++ = window[offset++];
+            length -= 1U;
+        }
+        while (length >= sizeof(word))
+        {
+            word = *(const volatile uint32_t *)&window[offset];
+            memcpy(data, &word, sizeof(word));
+            offset += sizeof(word);
+            data += sizeof(word);
+            length -= sizeof(word);
+        }
+        while (length > 0U)
+        {
+            *data++ = window[offset++];
+            length -= 1U;
+        }
     }
 
-    static bool serial_driver_byte_fifo_is_full(const uart_byte_fifo_t *fifo)
+    static void serial_driver_rx_error_log_reset(serial_rx_error_log_t *log)
     {
-        return fifo != NULL && fifo->count == UART_DEVICE_FIFO_SIZE_BYTES;
+        log->first = 0U;
+        log->count = 0U;
+        log->rx_offset = 0U;
+        log->dropped = 0U;
     }
 
-    static void serial_driver_byte_fifo_push(uart_byte_fifo_t *fifo,
-                                             uint8_t byte)
+    static void serial_driver_rx_error_log_push(serial_rx_error_log_t *log,
+                                                uint64_t offset, uint8_t lsr)
     {
-        if (fifo == NULL)
+        serial_rx_error_t *record = NULL;
+
+        if (log->count == SERIAL_RX_ERROR_LOG_DEPTH)
         {
+            log->dropped += 1U;
             return;
         }
 
-        fifo->data[fifo->head] = byte;
-        fifo->head = (fifo->head + 1U) % UART_DEVICE_FIFO_SIZE_BYTES;
-        fifo->count += 1U;
+        record = &log->entries[(log->first + log->count) %
+                               SERIAL_RX_ERROR_LOG_DEPTH];
+        record->offset = offset;
+        record->lsr = lsr;
+        if ((lsr & UART_LSR_OVERRUN_BIT) != 0U)
+        {
+            record->error = UART_ERROR_OVERRUN;
+        }
+        else if ((lsr & UART_LSR_PARITY_BIT) != 0U)
+        {
+            record->error = UART_ERROR_PARITY;
+        }
+        else
+        {
+            record->error = UART_ERROR_FRAMING;
+        }
+        log->count += 1U;
     }
 
-    static bool serial_driver_byte_fifo_is_empty(const uart_byte_fifo_t *fifo)
+    /*
+     * Log every byte of @p status with an error bit set. Clean data is the
+     * common case, so eight status bytes are tested per 64-bit word and only
+     * a non-zero word is walked byte by byte.
+     */
+    static void serial_driver_scan_rx_status(serial_rx_error_log_t *log,
+                                             const uint8_t *status,
+                                             size_t length)
     {
-        return fifo == NULL || fifo->count == 0U; /* LCOV_EXCL_BR_LINE */
-    }
+        const uint64_t error_mask =
+            (uint64_t)UART_LSR_RX_ERROR_MASK * 0x0101010101010101ULL;
+        uint64_t word = 0U;
+        size_t index = 0U;
 
-    static uint8_t serial_driver_byte_fifo_pop(uart_byte_fifo_t *fifo)
-    {
-        uint8_t byte = 0U;
+        for (index = 0U; index + sizeof(word) <= length;
+             index += sizeof(word))
+        {
+            memcpy(&word, &status[index], sizeof(word));
+            if ((word & error_mask) != 0U)
+            {
+                size_t lane = 0U;
 
-        if (fifo == NULL)
+                for (lane = index; lane < index + sizeof(word); ++lane)
+                {
+                    if ((status[lane] & UART_LSR_RX_ERROR_MASK) != 0U)
+                    {
+                        serial_driver_rx_error_log_push(
+                            log, log->rx_offset + lane, status[lane]);
+                    }
+                }
+            }
+        }
+        for (; index < length; ++index)
         {
-            return 0U;
+            if ((status[index] & UART_LSR_RX_ERROR_MASK) != 0U)
+            {
+                serial_driver_rx_error_log_push(log, log->rx_offset + index,
+                                                status[index]);
+            }
         }
-
-        byte = fifo->data[fifo->tail];
-        fifo->tail = (fifo->tail + 1U) % UART_DEVICE_FIFO_SIZE_BYTES;
-        fifo->count -= 1U;
-        return byte;
     }
 
     static serial_driver_error_t serial_driver_common_init(void)
@@ -116,20 +256,36 @@ extern "C"
             serial_descriptor_map[index].uart_device = NULL;
             serial_descriptor_map[index].port_index = UART_DEVICE_COUNT;
             serial_descriptor_map[index].mode = UART_PORT_MODE_DISCRETE;
-            serial_descriptor_map[index].tx_input_staged_word = 0U;
-            serial_descriptor_map[index].tx_input_staged_word_bytes = 0U;
-            serial_descriptor_map[index].staged_word = 0U;
-            serial_descriptor_map[index].staged_word_bytes = 0U;
-            serial_descriptor_map[index].rx_staged_word = 0U;
-            serial_descriptor_map[index].rx_staged_word_bytes = 0U;
-            serial_descriptor_map[index].rx_output_staged_word = 0U;
-            serial_descriptor_map[index].rx_output_staged_word_bytes = 0U;
+            serial_descriptor_map[index].write_mode =
+                SERIAL_WRITE_MODE_SINGLE_PRODUCER;
             serial_descriptor_map[index].initialized = false;
+            serial_descriptor_map[index].poll_tx_budget =
+                UART_DEVICE_FIFO_SIZE_BYTES;
+            serial_descriptor_map[index].poll_rx_budget =
+                UART_DEVICE_FIFO_SIZE_BYTES;
+            serial_descriptor_map[index].poll_policy =
+                SERIAL_POLL_POLICY_TX_FIRST;
+            serial_descriptor_map[index].poll_rx_next = false;
+            serial_descriptor_map[index].data_path =
+                SERIAL_DATA_PATH_SOFTWARE_FIFO;
+            serial_descriptor_map[index].flow_control =
+                SERIAL_FLOW_CONTROL_NONE;
+            serial_descriptor_map[index].rx_throttled = false;
+            serial_descriptor_map[index].tx_xoff_held = false;
+            serial_descriptor_map[index].flow_char_pending = false;
 
             uart_devices[index].configured = false;
             uart_devices[index].port_mode = UART_PORT_MODE_DISCRETE;
+            uart_devices[index].tx_queue = NULL;
+            uart_devices[index].rx_queue = NULL;
+            uart_device_info[index].line_baud = 0U;
+            uart_device_info[index].line_lcr = 0U;
+            serial_driver_rx_error_log_reset(&serial_rx_error_logs[index]);
         }
 
+        serial_queue_pool_used = 0U;
+        serial_queue_arena_used = 0U;
+
         for (index = 0U; index < UART_FIFO_UART_COUNT; ++index)
         {
             serial_driver_byte_fifo_reset(&uart_fifo_map.write_fifos[index]);
@@ -140,6 +296,95 @@ extern "C"
         return SERIAL_DRIVER_OK;
     }
 
+    /*
+     * Resolve the storage for one ring: caller storage as given, otherwise a
+     * cache-line-rounded slice of uart_queue_arena past @p arena_used. The
+     * slice is only claimed once both rings of the port are bound.
+     */
+    static serial_driver_error_t
+    serial_driver_ring_storage(uint8_t *storage, size_t *capacity,
+                               size_t *arena_used, uint8_t **out_storage)
+    {
+        size_t slice = 0U;
+
+        if (storage != NULL)
+        {
+            *out_storage = storage;
+            return SERIAL_DRIVER_OK;
+        }
+        if (*capacity == 0U)
+        {
+            *capacity = SERIAL_QUEUE_FIXED_SIZE_BYTES;
+        }
+        if (*capacity > SERIAL_QUEUE_FIXED_SIZE_BYTES)
+        {
+            return SERIAL_DRIVER_ERROR_INVALID_ARG;
+        }
+
+        slice = ((*capacity + SERIAL_QUEUE_CACHE_LINE_BYTES - 1U) /
+                 SERIAL_QUEUE_CACHE_LINE_BYTES) *
+                SERIAL_QUEUE_CACHE_LINE_BYTES;
+        if (slice > UART_QUEUE_ARENA_BYTES - *arena_used)
+        {
+            return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+        }
+#if UART_QUEUE_ARENA_BYTES > 0
+        *out_storage = &uart_queue_arena[*arena_used];
+#endif
+        *arena_used += slice;
+        return SERIAL_DRIVER_OK;
+    }
+
+    /*
+     * Claim a queue pair from the pool for a serial-mode port and size its
+     * rings from @p config. Rings without caller storage are carved from
+     * uart_queue_arena; discrete ports never hold queue storage.
+     */
+    static serial_driver_error_t
+    serial_driver_bind_queues(uart_device_t *uart_device,
+                              const serial_port_config_t *config)
+    {
+        uart_queue_pair_t *pair = NULL;
+        size_t arena_used = serial_queue_arena_used;
+        size_t tx_capacity = config->tx_capacity;
+        size_t rx_capacity = config->rx_capacity;
+        uint8_t *tx_storage = NULL;
+        uint8_t *rx_storage = NULL;
+        serial_driver_error_t result = SERIAL_DRIVER_OK;
+
+        if (serial_queue_pool_used >= UART_SERIAL_QUEUE_POOL_SIZE)
+        {
+            return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+        }
+        pair = &uart_queue_pool[serial_queue_pool_used];
+
+        result = serial_driver_ring_storage(config->tx_storage, &tx_capacity,
+                                            &arena_used, &tx_storage);
+        if (result == SERIAL_DRIVER_OK)
+        {
+            result = serial_driver_ring_storage(
+                config->rx_storage, &rx_capacity, &arena_used, &rx_storage);
+        }
+        if (result != SERIAL_DRIVER_OK)
+        {
+            return result;
+        }
+
+        if (serial_queue_init_bytes_ex(&pair->tx_queue, tx_storage,
+                                       tx_capacity) != UART_ERROR_NONE ||
+            serial_queue_init_bytes_ex(&pair->rx_queue, rx_storage,
+                                       rx_capacity) != UART_ERROR_NONE)
+        {
+            return SERIAL_DRIVER_ERROR_INVALID_ARG;
+        }
+
+        serial_queue_pool_used += 1U;
+        serial_queue_arena_used = arena_used;
+        uart_device->tx_queue = &pair->tx_queue;
+        uart_device->rx_queue = &pair->rx_queue;
+        return SERIAL_DRIVER_OK;
+    }
+
     static serial_driver_error_t
     serial_driver_get_mode_entry(serial_descriptor_t descriptor,
                                  uart_port_mode_t mode,
@@ -172,129 +417,217 @@ extern "C"
         return SERIAL_DRIVER_OK;
     }
 
-    static serial_driver_error_t
-    serial_driver_load_tx_staged_word(serial_descriptor_entry_t *entry,
-                                      bool *out_no_data)
+    /* Software flow control holds TX while CTS is low or after an XOFF. */
+    static bool
+    serial_driver_flow_tx_held(const serial_descriptor_entry_t *entry)
     {
-        uint32_t word = 0U;
-        uart_error_t queue_error = UART_ERROR_NONE;
+        if (entry->flow_control == SERIAL_FLOW_CONTROL_SW_RTS_CTS)
+        {
+            return (entry->uart_device->registers->uart.msr_or_rs485dly.msr &
+                    UART_MSR_CTS_BIT) == 0U;
+        }
+        return entry->flow_control == SERIAL_FLOW_CONTROL_SW_XON_XOFF &&
+               entry->tx_xoff_held;
+    }
 
-        *out_no_data = false;
+    /*
+     * Software XON/XOFF: put the pending flow character into the device
+     * FIFO ahead of queued data. It is sent even while TX is held, and
+     * stays pending while the FIFO is full.
+     */
+    static void
+    serial_driver_flow_send_char(serial_descriptor_entry_t *entry)
+    {
+        xr17c358_channel_register_map_t *registers =
+            entry->uart_device->registers;
+        uart_byte_fifo_t *fifo = NULL;
+        uint8_t flow_char = 0U;
 
-        if (serial_queue_size(&entry->uart_device->tx_queue) ==
-                0U && /* LCOV_EXCL_BR_LINE */
-            entry->tx_input_staged_word_bytes > 0U)
+        if (!entry->flow_char_pending)
         {
-            entry->staged_word = entry->tx_input_staged_word;
-            entry->staged_word_bytes = entry->tx_input_staged_word_bytes;
-            entry->tx_input_staged_word = 0U;
-            entry->tx_input_staged_word_bytes = 0U;
-            return SERIAL_DRIVER_OK;
+            return;
         }
 
-        queue_error = serial_queue_pop(&entry->uart_device->tx_queue,
-                                       &word);          /* LCOV_EXCL_BR_LINE */
-        if (queue_error == UART_ERROR_FIFO_QUEUE_EMPTY) /* LCOV_EXCL_BR_LINE */
+        flow_char = entry->rx_throttled ? entry->xoff_char : entry->xon_char;
+        if (entry->data_path != SERIAL_DATA_PATH_SOFTWARE_FIFO)
         {
-            *out_no_data = true;
-            return SERIAL_DRIVER_OK;
+            if (XR17V358_FIFO_DEPTH -
+                    (size_t)registers->uart.txcnt_or_txtrg.txcnt ==
+                0U)
+            {
+                return;
+            }
+            serial_driver_mmio_burst_write(registers->fifo_data.tx_data, 0U,
+                                           &flow_char, 1U);
         }
-        if (queue_error != UART_ERROR_NONE)
+        else
         {
-            return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+            fifo = &uart_fifo_map.write_fifos[(size_t)entry->port_index];
+            if (fifo->count >= UART_DEVICE_FIFO_SIZE_BYTES)
+            {
+                return;
+            }
+            serial_driver_byte_fifo_write(fifo, &flow_char, 1U);
         }
-
-        entry->staged_word = word;
-        entry->staged_word_bytes = sizeof(uint32_t);
-        return SERIAL_DRIVER_OK;
+        entry->flow_char_pending = false;
     }
 
-    static serial_driver_error_t
-    serial_driver_transmit_to_device_fifo(serial_descriptor_entry_t *entry,
-                                          size_t max_bytes,
-                                          size_t *out_bytes_transmitted)
+    /*
+     * Software XON/XOFF: drop flow characters from @p length bytes received
+     * into @p first / @p second (and from their @p status bytes, if any),
+     * holding TX on XOFF and releasing it on XON. The remaining bytes are
+     * compacted to the front; returns their count.
+     */
+    static size_t serial_driver_flow_strip_rx(serial_descriptor_entry_t *entry,
+                                              serial_span_t first,
+                                              serial_span_t second,
+                                              uint8_t *status, size_t length)
     {
-        uart_byte_fifo_t *fifo = NULL;
-        size_t fifo_index = 0U;
-        size_t bytes_transmitted = 0U;
-        bool tx_data_unavailable = false;
-        serial_driver_error_t status = SERIAL_DRIVER_OK;
+        size_t kept = 0U;
+        size_t index = 0U;
 
-        if (out_bytes_transmitted == NULL)
+        if (entry->flow_control != SERIAL_FLOW_CONTROL_SW_XON_XOFF)
         {
-            return SERIAL_DRIVER_ERROR_INVALID_ARG;
+            return length;
         }
-        *out_bytes_transmitted = 0U;
-
-        fifo_index = (size_t)entry->port_index;
-        fifo = &uart_fifo_map.write_fifos[fifo_index];
 
-        while (bytes_transmitted < max_bytes &&
-               !serial_driver_byte_fifo_is_full(fifo))
+        for (index = 0U; index < length; ++index)
         {
-            if (entry->staged_word_bytes == 0U)
+            const uint8_t byte = (index < first.length)
+                                     ? first.data[index]
+                                     : second.data[index - first.length];
+
+            if (byte == entry->xoff_char || byte == entry->xon_char)
             {
-                status = serial_driver_load_tx_staged_word(
-                    entry, &tx_data_unavailable);
-                if (status != SERIAL_DRIVER_OK)
-                {
-                    return status;
-                }
-                if (tx_data_unavailable)
-                {
-                    break;
-                }
+                entry->tx_xoff_held = byte == entry->xoff_char;
+                continue;
             }
-
-            serial_driver_byte_fifo_push(fifo,
-                                         (uint8_t)(entry->staged_word & 0xFFU));
-            entry->staged_word >>= 8U;
-            entry->staged_word_bytes -= 1U;
-            bytes_transmitted += 1U;
+            if (kept < first.length)
+            {
+                first.data[kept] = byte;
+            }
+            else
+            {
+                second.data[kept - first.length] = byte;
+            }
+            if (status != NULL)
+            {
+                status[kept] = status[index];
+            }
+            ++kept;
         }
-
-        *out_bytes_transmitted = bytes_transmitted;
-        return SERIAL_DRIVER_OK;
+        return kept;
     }
 
+    /*
+     * Move queued TX bytes into the port's write FIFO. Free FIFO space is
+     * computed once and the queue is read in place, so the cost is one memcpy
+     * per wrap segment rather than per byte. On the MMIO burst path the free
+     * space comes from a single TXCNT read and the bytes go straight into the
+     * device FIFO window. Software flow control holds TX while CTS is low
+     * or the peer has sent XOFF; a pending XON/XOFF still goes out first.
+     */
     static serial_driver_error_t
-    serial_driver_flush_rx_staged_word(serial_descriptor_entry_t *entry,
-                                       bool *out_queue_full)
+    serial_driver_transmit_to_device_fifo(serial_descriptor_entry_t *entry,
+                                          size_t max_bytes,
+                                          size_t *out_bytes_transmitted)
     {
+        uart_byte_fifo_t *fifo = NULL;
+        serial_const_span_t first = {NULL, 0U};
+        serial_const_span_t second = {NULL, 0U};
+        size_t length = 0U;
+        size_t head_part = 0U;
+        uint8_t txcnt = 0U;
         uart_error_t queue_error = UART_ERROR_NONE;
 
-        *out_queue_full = false;
+        if (out_bytes_transmitted == NULL)
+        {
+            return SERIAL_DRIVER_ERROR_INVALID_ARG;
+        }
+        *out_bytes_transmitted = 0U;
 
-        queue_error = serial_queue_push(&entry->uart_device->rx_queue,
-                                        entry->rx_staged_word);
+        serial_driver_flow_send_char(entry);
+        if (serial_driver_flow_tx_held(entry))
+        {
+            return SERIAL_DRIVER_OK;
+        }
 
-        if (queue_error == UART_ERROR_NONE)
+        fifo = &uart_fifo_map.write_fifos[(size_t)entry->port_index];
+        if (entry->data_path != SERIAL_DATA_PATH_SOFTWARE_FIFO)
+        {
+            txcnt = entry->uart_device->registers->uart.txcnt_or_txtrg.txcnt;
+            length = XR17V358_FIFO_DEPTH - txcnt;
+        }
+        else
+        {
+            length = UART_DEVICE_FIFO_SIZE_BYTES - fifo->count;
+        }
+        if (length > max_bytes)
+        {
+            length = max_bytes;
+        }
+        if (length == 0U)
         {
-            entry->rx_staged_word = 0U;
-            entry->rx_staged_word_bytes = 0U;
             return SERIAL_DRIVER_OK;
         }
 
-        if (queue_error == UART_ERROR_FIFO_QUEUE_FULL)
+        queue_error =
+            serial_queue_peek_bytes(entry->uart_device->tx_queue, &first,
+                                    &second);
+        if (queue_error == UART_ERROR_FIFO_QUEUE_EMPTY)
         {
-            *out_queue_full = true;
             return SERIAL_DRIVER_OK;
         }
+        if (queue_error != UART_ERROR_NONE)
+        {
+            return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+        }
+
+        if (length > first.length + second.length)
+        {
+            length = first.length + second.length;
+        }
+        head_part = (length < first.length) ? length : first.length;
+        if (entry->data_path != SERIAL_DATA_PATH_SOFTWARE_FIFO)
+        {
+            volatile uint8_t *window =
+                entry->uart_device->registers->fifo_data.tx_data;
+
+            serial_driver_mmio_burst_write(window, 0U, first.data, head_part);
+            serial_driver_mmio_burst_write(window, head_part, second.data,
+                                           length - head_part);
+        }
+        else
+        {
+            serial_driver_byte_fifo_write(fifo, first.data, head_part);
+            serial_driver_byte_fifo_write(fifo, second.data,
+                                          length - head_part);
+        }
+        (void)serial_queue_consume_bytes(entry->uart_device->tx_queue, length);
 
-        return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+        *out_bytes_transmitted = length;
+        return SERIAL_DRIVER_OK;
     }
 
+    /*
+     * Move bytes from the port's read FIFO into the RX queue, writing
+     * straight into the queue's free space. On the MMIO burst paths the byte
+     * count comes from a single RXCNT read; the with-status path also pulls
+     * the matching LSR bytes and logs any errored ones. Software XON/XOFF
+     * characters are consumed here and never reach the queue.
+     */
     static serial_driver_error_t
     serial_driver_receive_from_device_fifo(serial_descriptor_entry_t *entry,
                                            size_t max_bytes,
                                            size_t *out_bytes_received)
     {
         uart_byte_fifo_t *fifo = NULL;
-        size_t fifo_index = 0U;
-        size_t bytes_received = 0U;
-        uint8_t byte = 0U;
-        bool queue_full = false;
-        serial_driver_error_t status = SERIAL_DRIVER_OK;
+        serial_rx_error_log_t *log = NULL;
+        serial_span_t first = {NULL, 0U};
+        serial_span_t second = {NULL, 0U};
+        size_t length = 0U;
+        size_t head_part = 0U;
+        uart_error_t queue_error = UART_ERROR_NONE;
 
         if (out_bytes_received == NULL)
         {
@@ -302,51 +635,78 @@ extern "C"
         }
         *out_bytes_received = 0U;
 
-        fifo_index = (size_t)entry->port_index;
-        fifo = &uart_fifo_map.read_fifos[fifo_index];
+        fifo = &uart_fifo_map.read_fifos[(size_t)entry->port_index];
+        log = &serial_rx_error_logs[(size_t)entry->port_index];
 
-        while (bytes_received < max_bytes)
+        queue_error = serial_queue_reserve_bytes(entry->uart_device->rx_queue,
+                                                 0U, &first, &second);
+        if (queue_error == UART_ERROR_FIFO_QUEUE_FULL)
         {
-            if (entry->rx_staged_word_bytes == sizeof(uint32_t))
-            {
-                status = serial_driver_flush_rx_staged_word(
-                    entry, &queue_full); /* LCOV_EXCL_BR_LINE */
-                if (status != SERIAL_DRIVER_OK)
-                {
-                    *out_bytes_received = bytes_received;
-                    return status;
-                }
-                if (queue_full)
-                {
-                    break;
-                }
-                continue;
-            }
-
-            if (serial_driver_byte_fifo_is_empty(fifo))
-            {
-                break;
-            }
+            return SERIAL_DRIVER_OK;
+        }
+        if (queue_error != UART_ERROR_NONE)
+        {
+            return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+        }
 
-            byte = serial_driver_byte_fifo_pop(fifo);
-            entry->rx_staged_word |= ((uint32_t)byte)
-                                     << (8U * entry->rx_staged_word_bytes);
-            entry->rx_staged_word_bytes += 1U;
-            bytes_received += 1U;
+        if (entry->data_path != SERIAL_DATA_PATH_SOFTWARE_FIFO)
+        {
+            length = entry->uart_device->registers->uart.rxcnt_or_rxtrg.rxcnt;
+        }
+        else
+        {
+            length = fifo->count;
+        }
+        if (length > max_bytes)
+        {
+            length = max_bytes;
         }
+        if (length > first.length + second.length)
+        {
+            length = first.length + second.length;
+        }
+        head_part = (length < first.length) ? length : first.length;
+        if (entry->data_path == SERIAL_DATA_PATH_MMIO_BURST)
+        {
+            const volatile uint8_t *window =
+                entry->uart_device->registers->fifo_data.rx_data;
 
-        if (entry->rx_staged_word_bytes == sizeof(uint32_t))
+            serial_driver_mmio_burst_read(window, 0U, first.data, head_part);
+            serial_driver_mmio_burst_read(window, head_part, second.data,
+                                          length - head_part);
+        }
+        else if (entry->data_path == SERIAL_DATA_PATH_MMIO_BURST_WITH_STATUS)
         {
-            status = serial_driver_flush_rx_staged_word(
-                entry, &queue_full); /* LCOV_EXCL_BR_LINE */
-            if (status != SERIAL_DRIVER_OK)
-            {
-                *out_bytes_received = bytes_received;
-                return status;
-            }
+            const volatile xr17v358_fifo_data_with_status_registers_t *window =
+                &entry->uart_device->registers->fifo_data_with_status;
+            uint8_t status[XR17V358_FIFO_DEPTH];
+
+            /* Status first: reading the data bytes pops the FIFO. */
+            serial_driver_mmio_burst_read(window->lsr_status, 0U, status,
+                                          length);
+            serial_driver_mmio_burst_read(window->data, 0U, first.data,
+                                          head_part);
+            serial_driver_mmio_burst_read(window->data, head_part,
+                                          second.data, length - head_part);
+            length = serial_driver_flow_strip_rx(entry, first, second, status,
+                                                 length);
+            serial_driver_scan_rx_status(log, status, length);
+        }
+        else
+        {
+            serial_driver_byte_fifo_read(fifo, first.data, head_part);
+            serial_driver_byte_fifo_read(fifo, second.data,
+                                         length - head_part);
+        }
+        if (entry->data_path != SERIAL_DATA_PATH_MMIO_BURST_WITH_STATUS)
+        {
+            length = serial_driver_flow_strip_rx(entry, first, second, NULL,
+                                                 length);
         }
+        (void)serial_queue_commit_bytes(entry->uart_device->rx_queue, length);
+        log->rx_offset += length;
 
-        *out_bytes_received = bytes_received;
+        *out_bytes_received = length;
         return SERIAL_DRIVER_OK;
     }
 
@@ -19,15 +19,17 @@ extern "C"
      * @brief Callback used to map one UART device to platform registers.
      *
      * The callback should populate at minimum @p uart_device->registers and may
-     * also set fields such as @p uart_device->uart_base_address or
-     * @p uart_device->device_name.
+     * also set @p device_info->uart_base_address or
+     * @p device_info->device_name.
      *
      * @param port_index UART port index in range [0, UART_DEVICE_COUNT).
      * @param uart_device UART device entry associated with @p port_index.
+     * @param device_info Setup-only state associated with @p port_index.
      * @return @ref UART_ERROR_NONE on success, otherwise an error code.
      */
-    typedef uart_error_t (*serial_driver_hw_map_fn)(size_t port_index,
-                                                    uart_device_t *uart_device);
+    typedef uart_error_t (*serial_driver_hw_map_fn)(
+        size_t port_index, uart_device_t *uart_device,
+        uart_device_info_t *device_info);
 
     /**
      * @brief Register a platform-specific UART mapping callback.
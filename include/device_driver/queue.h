@@ -3,7 +3,7 @@
 
 /**
  * @file queue.h
- * @brief Simple 32-bit circular queue utilities.
+ * @brief Simple circular queue utilities for 32-bit words or raw bytes.
  */
 
 #include <stdbool.h>
@@ -12,61 +12,346 @@
 
 #include "device_driver/errors.h"
 
+#if defined(__cplusplus)
+/* C++ callers only see the layout; all index access goes through queue.c. */
+#define SERIAL_QUEUE_ATOMIC(type) type
+#define SERIAL_QUEUE_ALIGNAS(bytes) alignas(bytes)
+#else
+#include <stdatomic.h>
+#define SERIAL_QUEUE_ATOMIC(type) _Atomic(type)
+#define SERIAL_QUEUE_ALIGNAS(bytes) _Alignas(bytes)
+#endif
+
+/** Cache-line size used to keep producer and consumer indices apart. */
+#define SERIAL_QUEUE_CACHE_LINE_BYTES 64
+
 /** Fixed queue storage size in 32-bit entries 300 entries(1.2K byte). */
 #define SERIAL_QUEUE_FIXED_SIZE_WORDS 300U
 
+/** Fixed queue storage size in bytes (same storage viewed as bytes). */
+#define SERIAL_QUEUE_FIXED_SIZE_BYTES                                          \
+    (SERIAL_QUEUE_FIXED_SIZE_WORDS * (size_t)sizeof(uint32_t))
+
+/** Largest byte-queue capacity accepted by @ref serial_queue_init_bytes_ex. */
+#define SERIAL_QUEUE_MAX_CAPACITY_BYTES ((size_t)1U << 30)
+
+/**
+ * @brief Entry granularity of a queue.
+ */
+typedef enum SerialQueueMode {
+  /** Queue entries are 32-bit words (@ref serial_queue_push and friends). */
+  SERIAL_QUEUE_MODE_WORD = 0,
+  /** Queue entries are bytes (@ref serial_queue_push_bytes and friends). */
+  SERIAL_QUEUE_MODE_BYTE
+} serial_queue_mode_t;
+
+/**
+ * @brief Writable region inside a byte queue's storage.
+ */
+typedef struct SerialSpan {
+  /** First byte of the region, or NULL when empty. */
+  uint8_t *data;
+  /** Region length in bytes. */
+  size_t length;
+} serial_span_t;
+
 /**
- * @brief Circular queue for 32-bit storage.
+ * @brief Read-only region inside a byte queue's storage.
+ */
+typedef struct SerialConstSpan {
+  /** First byte of the region, or NULL when empty. */
+  const uint8_t *data;
+  /** Region length in bytes. */
+  size_t length;
+} serial_const_span_t;
+
+/**
+ * @brief Fixed-size backing storage for one queue (1.2 KB), viewed per
+ * @ref serial_queue_mode_t.
+ *
+ * Kept apart from @ref serial_queue_t so a queue control block carries no
+ * storage of its own.
+ */
+typedef union SerialQueueBuffer {
+  /** Word view used by @ref SERIAL_QUEUE_MODE_WORD queues. */
+  uint32_t words[SERIAL_QUEUE_FIXED_SIZE_WORDS];
+  /** Byte view used by @ref SERIAL_QUEUE_MODE_BYTE queues. */
+  uint8_t bytes[SERIAL_QUEUE_FIXED_SIZE_BYTES];
+} serial_queue_buffer_t;
+
+/**
+ * @brief Single-producer/single-consumer circular queue control block over
+ * separately owned storage.
+ *
+ * One thread may push while another thread pops without external locking.
+ * @ref head is only written by the producer and @ref tail only by the
+ * consumer; the two sit on separate cache lines and there is no shared
+ * count.
+ * Both indices are free-running 64-bit counters, also on targets with a
+ * 32-bit size_t, folded into a storage offset only on access. A full queue
+ * is therefore distinguishable from an empty one without a separate
+ * counter, the fold stays continuous for any capacity, and an index value
+ * is never reused while a producer may still hold it. Power-of-two
+ * capacities fold with a mask.
  */
 typedef struct {
-  /** Fixed-size backing storage buffer. */
-  uint32_t buffer[SERIAL_QUEUE_FIXED_SIZE_WORDS];
-  /** Write index for next pushed word. */
-  size_t head;
-  /** Read index for next popped word. */
-  size_t tail;
-  /** Number of 32-bit words currently queued. */
-  size_t count;
+  /** Backing storage: a @ref serial_queue_buffer_t or caller bytes. */
+  uint8_t *storage;
+  /** Capacity in entries for the active mode. */
+  size_t capacity;
+  /** capacity - 1 for power-of-two capacities, otherwise 0. */
+  size_t index_mask;
+  /** Entry granularity selected at initialization. */
+  serial_queue_mode_t mode;
   /** Set to true once queue has been initialized. */
   bool initialized;
+  /** Producer-owned write index for next pushed entry. */
+  SERIAL_QUEUE_ALIGNAS(SERIAL_QUEUE_CACHE_LINE_BYTES)
+  SERIAL_QUEUE_ATOMIC(uint64_t) head;
+  /**
+   * Multi-producer reservation index (ahead of or equal to @ref head).
+   * Producer-side like @ref head, so it shares that cache line.
+   */
+  SERIAL_QUEUE_ATOMIC(uint64_t) reserve;
+  /** Consumer-owned read index for next popped entry. */
+  SERIAL_QUEUE_ALIGNAS(SERIAL_QUEUE_CACHE_LINE_BYTES)
+  SERIAL_QUEUE_ATOMIC(uint64_t) tail;
 } serial_queue_t;
 
 /**
- * @brief Initialize a queue with built-in fixed storage.
+ * @brief Initialize a word queue over a fixed-size buffer.
  *
  * @param queue Queue context to initialize.
+ * @param buffer Backing storage; must outlive the queue.
  * @return @ref UART_ERROR_NONE on success, otherwise an error code.
  */
-uart_error_t serial_queue_init(serial_queue_t *queue);
+uart_error_t serial_queue_init(serial_queue_t *queue,
+                               serial_queue_buffer_t *buffer);
 
 /**
- * @brief Push one 32-bit word into the queue.
+ * @brief Initialize a byte queue over a fixed-size buffer.
  *
- * @param queue Initialized queue context.
+ * Byte queues hold @ref SERIAL_QUEUE_FIXED_SIZE_BYTES bytes and are accessed
+ * with @ref serial_queue_push_bytes / @ref serial_queue_pop_bytes.
+ *
+ * @param queue Queue context to initialize.
+ * @param buffer Backing storage; must outlive the queue.
+ * @return @ref UART_ERROR_NONE on success, otherwise an error code.
+ */
+uart_error_t serial_queue_init_bytes(serial_queue_t *queue,
+                                     serial_queue_buffer_t *buffer);
+
+/**
+ * @brief Initialize a byte queue with a chosen capacity over caller-supplied
+ * storage.
+ *
+ * @p storage must hold @p capacity bytes and outlive the queue; it may be a
+ * static arena, a huge page or shared memory. Power-of-two capacities take a
+ * cheaper mask-based index path.
+ *
+ * @param queue Queue context to initialize.
+ * @param storage Backing bytes.
+ * @param capacity Capacity in bytes, 1 to
+ * @ref SERIAL_QUEUE_MAX_CAPACITY_BYTES.
+ * @return @ref UART_ERROR_NONE on success, otherwise an error code.
+ */
+uart_error_t serial_queue_init_bytes_ex(serial_queue_t *queue,
+                                        uint8_t *storage, size_t capacity);
+
+/**
+ * @brief Push one 32-bit word into the queue (producer side).
+ *
+ * @param queue Initialized word queue context.
  * @param value Word to enqueue.
  * @return @ref UART_ERROR_NONE on success, otherwise an error code.
  */
 uart_error_t serial_queue_push(serial_queue_t *queue, uint32_t value);
 
 /**
- * @brief Pop one 32-bit word from the queue.
+ * @brief Pop one 32-bit word from the queue (consumer side).
  *
- * @param queue Initialized queue context.
+ * @param queue Initialized word queue context.
  * @param out_value Output pointer for popped word.
  * @return @ref UART_ERROR_NONE on success, otherwise an error code.
  */
 uart_error_t serial_queue_pop(serial_queue_t *queue, uint32_t *out_value);
 
 /**
- * @brief Return current queued word count.
+ * @brief Push up to @p count 32-bit words into the queue (producer side).
+ *
+ * Words are copied with at most two block copies (before and after the wrap
+ * point). Fewer than @p count words are accepted when free space runs out.
+ *
+ * @param queue Initialized word queue context.
+ * @param values Input word buffer.
+ * @param count Number of words to enqueue.
+ * @param out_pushed Output number of words accepted.
+ * @return @ref UART_ERROR_NONE when at least one word (or zero requested
+ * words) was accepted, @ref UART_ERROR_FIFO_QUEUE_FULL when none fit,
+ * otherwise an error code.
+ */
+uart_error_t serial_queue_push_n(serial_queue_t *queue, const uint32_t *values,
+                                 size_t count, size_t *out_pushed);
+
+/**
+ * @brief Pop up to @p count 32-bit words from the queue (consumer side).
+ *
+ * Words are copied with at most two block copies (before and after the wrap
+ * point).
+ *
+ * @param queue Initialized word queue context.
+ * @param out_values Output word buffer.
+ * @param count Maximum number of words to dequeue.
+ * @param out_popped Output number of words dequeued.
+ * @return @ref UART_ERROR_NONE when at least one word (or zero requested
+ * words) was dequeued, @ref UART_ERROR_FIFO_QUEUE_EMPTY when none were
+ * available, otherwise an error code.
+ */
+uart_error_t serial_queue_pop_n(serial_queue_t *queue, uint32_t *out_values,
+                                size_t count, size_t *out_popped);
+
+/**
+ * @brief Push up to @p count bytes into a byte queue (producer side).
+ *
+ * Bytes are copied with at most two block copies (before and after the wrap
+ * point). Fewer than @p count bytes are accepted when free space runs out.
+ *
+ * @param queue Initialized byte queue context.
+ * @param data Input byte buffer.
+ * @param count Number of bytes to enqueue.
+ * @param out_pushed Output number of bytes accepted.
+ * @return @ref UART_ERROR_NONE when at least one byte (or zero requested
+ * bytes) was accepted, @ref UART_ERROR_FIFO_QUEUE_FULL when none fit,
+ * otherwise an error code.
+ */
+uart_error_t serial_queue_push_bytes(serial_queue_t *queue,
+                                     const uint8_t *data, size_t count,
+                                     size_t *out_pushed);
+
+/**
+ * @brief Pop up to @p count bytes from a byte queue (consumer side).
+ *
+ * @param queue Initialized byte queue context.
+ * @param out_data Output byte buffer.
+ * @param count Maximum number of bytes to dequeue.
+ * @param out_popped Output number of bytes dequeued.
+ * @return @ref UART_ERROR_NONE when at least one byte (or zero requested
+ * bytes) was dequeued, @ref UART_ERROR_FIFO_QUEUE_EMPTY when none were
+ * available, otherwise an error code.
+ */
+uart_error_t serial_queue_pop_bytes(serial_queue_t *queue, uint8_t *out_data,
+                                    size_t count, size_t *out_popped);
+
+/**
+ * @brief Expose free space of a byte queue for in-place writes (producer
+ * side).
+ *
+ * All free space is returned as up to two spans: @p out_first starts at the
+ * write position and runs to the end of storage or the free-space limit, and
+ * @p out_second (possibly empty) continues from the start of storage. Fill
+ * the spans in order, then publish bytes with @ref serial_queue_commit_bytes.
+ *
+ * @param queue Initialized byte queue context.
+ * @param min_count Minimum number of free bytes required.
+ * @param out_first Output first writable span.
+ * @param out_second Output second writable span after the wrap point.
+ * @return @ref UART_ERROR_NONE on success, @ref UART_ERROR_FIFO_QUEUE_FULL
+ * when fewer than @p min_count bytes are free, otherwise an error code.
+ */
+uart_error_t serial_queue_reserve_bytes(serial_queue_t *queue,
+                                        size_t min_count,
+                                        serial_span_t *out_first,
+                                        serial_span_t *out_second);
+
+/**
+ * @brief Publish @p count bytes written into spans from
+ * @ref serial_queue_reserve_bytes (producer side).
+ *
+ * @param queue Initialized byte queue context.
+ * @param count Number of bytes to publish, starting at the first span.
+ * @return @ref UART_ERROR_NONE on success, @ref UART_ERROR_INVALID_ARG when
+ * @p count exceeds the free space, otherwise an error code.
+ */
+uart_error_t serial_queue_commit_bytes(serial_queue_t *queue, size_t count);
+
+/**
+ * @brief Expose queued bytes of a byte queue without removing them (consumer
+ * side).
+ *
+ * Queued bytes are returned in order as up to two spans; @p out_second is
+ * non-empty only when the data wraps past the end of storage. The spans stay
+ * valid until the bytes are released with @ref serial_queue_consume_bytes.
+ *
+ * @param queue Initialized byte queue context.
+ * @param out_first Output first readable span.
+ * @param out_second Output second readable span after the wrap point.
+ * @return @ref UART_ERROR_NONE on success, @ref UART_ERROR_FIFO_QUEUE_EMPTY
+ * when nothing is queued, otherwise an error code.
+ */
+uart_error_t serial_queue_peek_bytes(serial_queue_t *queue,
+                                     serial_const_span_t *out_first,
+                                     serial_const_span_t *out_second);
+
+/**
+ * @brief Release @p count bytes from the front of a byte queue (consumer
+ * side).
+ *
+ * @param queue Initialized byte queue context.
+ * @param count Number of bytes to drop.
+ * @return @ref UART_ERROR_NONE on success, @ref UART_ERROR_INVALID_ARG when
+ * @p count exceeds the queued size, otherwise an error code.
+ */
+uart_error_t serial_queue_consume_bytes(serial_queue_t *queue, size_t count);
+
+/**
+ * @brief Push all @p count bytes into a byte queue from one of several
+ * concurrent producers.
+ *
+ * The producer atomically reserves a contiguous range past @ref reserve,
+ * copies into it, then waits for earlier reservations to commit before
+ * publishing its own, so each call's bytes stay contiguous and the consumer
+ * only ever sees committed data. Nothing is queued unless all bytes fit.
+ * Call @ref serial_queue_sync_producers before switching a queue from
+ * single-producer pushes to this function.
+ *
+ * @param queue Initialized byte queue context.
+ * @param data Input byte buffer.
+ * @param count Number of bytes to enqueue.
+ * @return @ref UART_ERROR_NONE when all bytes were queued,
+ * @ref UART_ERROR_FIFO_QUEUE_FULL when they did not fit, otherwise an error
+ * code.
+ */
+uart_error_t serial_queue_push_bytes_mp(serial_queue_t *queue,
+                                        const uint8_t *data, size_t count);
+
+/**
+ * @brief Align the multi-producer reservation index with @ref head.
+ *
+ * Must be called while no producer is active.
+ *
+ * @param queue Initialized queue context.
+ * @return @ref UART_ERROR_NONE on success, otherwise an error code.
+ */
+uart_error_t serial_queue_sync_producers(serial_queue_t *queue);
+
+/**
+ * @brief Return current queued entry count.
  *
  * @param queue Queue context.
- * @return Number of words currently queued, or 0 for invalid queue.
+ * @return Number of entries currently queued, or 0 for invalid queue.
  */
 size_t serial_queue_size(const serial_queue_t *queue);
 
 /**
- * @brief Return whether queue has no queued bytes.
+ * @brief Return number of entries that can still be queued.
+ *
+ * @param queue Queue context.
+ * @return Free entries, or 0 for invalid queue.
+ */
+size_t serial_queue_space(const serial_queue_t *queue);
+
+/**
+ * @brief Return whether queue has no queued entries.
  *
  * @param queue Queue context.
  * @return true if queue is empty or invalid; otherwise false.
@@ -74,7 +359,7 @@ size_t serial_queue_size(const serial_queue_t *queue);
 bool serial_queue_is_empty(const serial_queue_t *queue);
 
 /**
- * @brief Return whether queue cannot accept more bytes.
+ * @brief Return whether queue cannot accept more entries.
  *
  * @param queue Queue context.
  * @return true if queue is full; otherwise false.
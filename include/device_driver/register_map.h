@@ -36,6 +36,34 @@
 /** MCR bit 4: local loopback enable. */
 #define UART_MCR_LOOPBACK_BIT (1U << 4U)
 
+/** LCR bits 1:0: word length minus 5. */
+#define UART_LCR_WORD_LENGTH_MASK 0x03U
+/** LCR bit 2: two stop bits (1.5 for 5-bit words). */
+#define UART_LCR_STOP_BITS_BIT (1U << 2U)
+/** LCR bit 3: parity enable. */
+#define UART_LCR_PARITY_ENABLE_BIT (1U << 3U)
+/** LCR bit 4: even parity select. */
+#define UART_LCR_EVEN_PARITY_BIT (1U << 4U)
+/** LCR bit 5: stick (mark/space) parity. */
+#define UART_LCR_STICK_PARITY_BIT (1U << 5U)
+/** LCR bit 7: divisor latch access (DLL/DLM at offsets 0x00/0x01). */
+#define UART_LCR_DLAB_BIT (1U << 7U)
+
+/** LSR bit 0: receive data ready. */
+#define UART_LSR_DATA_READY_BIT (1U << 0U)
+/** LSR bit 1: receiver overrun error. */
+#define UART_LSR_OVERRUN_BIT (1U << 1U)
+/** LSR bit 2: receive parity error. */
+#define UART_LSR_PARITY_BIT (1U << 2U)
+/** LSR bit 3: receive framing error. */
+#define UART_LSR_FRAMING_BIT (1U << 3U)
+/** LSR bit 4: break interrupt. */
+#define UART_LSR_BREAK_BIT (1U << 4U)
+/** LSR bits that mark a received byte as errored. */
+#define UART_LSR_RX_ERROR_MASK                                                 \
+    (UART_LSR_OVERRUN_BIT | UART_LSR_PARITY_BIT | UART_LSR_FRAMING_BIT |       \
+     UART_LSR_BREAK_BIT)
+
 /**
  * @brief Discrete line control bit for XR17C358/XR17V358 channels.
  *
@@ -139,6 +167,47 @@
 /** XR17V358 channel offset 0x9A (MPIOOD[15:8]). */
 #define XR17V358_REG_OFFSET_MPIOOD_15_8 0x009AU
 
+/** MSR bit 4: CTS input state. */
+#define UART_MSR_CTS_BIT (1U << 4U)
+
+/** EFR bits 3:0: in-band (XON/XOFF) flow control select. */
+#define XR17V358_EFR_SW_FLOW_MASK 0x0FU
+/** EFR[3:0] = 1010: transmit and receive in-band flow control on XON1/XOFF1. */
+#define XR17V358_EFR_SW_FLOW_XON1_XOFF1 0x0AU
+/** EFR bit 6: auto RTS flow control enable. */
+#define XR17V358_EFR_AUTO_RTS_BIT (1U << 6U)
+/** EFR bit 7: auto CTS flow control enable. */
+#define XR17V358_EFR_AUTO_CTS_BIT (1U << 7U)
+/** Conventional XON (DC1) character. */
+#define UART_XON_CHAR 0x11U
+/** Conventional XOFF (DC3) character. */
+#define UART_XOFF_CHAR 0x13U
+/** EFR bit 4: enhanced function enable (selects TXTRG/RXTRG at 0x0A/0x0B). */
+#define XR17V358_EFR_ENHANCED_BIT (1U << 4U)
+/** FCTR bits 7:6: TX/RX FIFO trigger table select. */
+#define XR17V358_FCTR_TRIGGER_TABLE_MASK (3U << 6U)
+/** FCTR trigger table D: levels programmed through TXTRG/RXTRG. */
+#define XR17V358_FCTR_TRIGGER_TABLE_D (3U << 6U)
+
+/** INT0 bit n is set while channel n has an interrupt pending. */
+#define XR17V358_INT0_CHANNEL_BIT(channel) (1U << (channel))
+/** Width of one channel's source code in the 24-bit INT3:INT2:INT1 field. */
+#define XR17V358_INT_SOURCE_BITS 3U
+/** Mask of one channel's INT1-INT3 source code. */
+#define XR17V358_INT_SOURCE_MASK 0x7U
+/** INT1-INT3 source: none (or wake-up indicator). */
+#define XR17V358_INT_SOURCE_NONE 0x0U
+/** INT1-INT3 source: RXRDY and RX line status. */
+#define XR17V358_INT_SOURCE_RX_LINE_STATUS 0x1U
+/** INT1-INT3 source: RXRDY time-out. */
+#define XR17V358_INT_SOURCE_RX_TIMEOUT 0x2U
+/** INT1-INT3 source: TXRDY (THR/TSR empty). */
+#define XR17V358_INT_SOURCE_TX_EMPTY 0x3U
+/** INT1-INT3 source: modem status, flow control or special character. */
+#define XR17V358_INT_SOURCE_MODEM_STATUS 0x4U
+/** INT1-INT3 source: MPIO pin(s). */
+#define XR17V358_INT_SOURCE_MPIO 0x7U
+
 /** XR17V358 global offset 0x0100 (channel 0 FIFO read/write data). */
 #define XR17V358_REG_OFFSET_CHANNEL_0_FIFO_DATA 0x0100U
 /** XR17V358 global offset 0x0200 (channel 0 FIFO data with status). */
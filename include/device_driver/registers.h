@@ -13,14 +13,47 @@
 #include "device_driver/queue.h"
 #include "device_driver/register_map.h"
 
-/** Number of UART device slots tracked in @ref uart_devices. */
+/**
+ * Number of UART device slots tracked in @ref uart_devices. Define it (up to
+ * 32, four XR17V358 cards) for multi-card systems; serial_ports_t then names
+ * the ports of every card.
+ */
+#ifndef UART_DEVICE_COUNT
 #define UART_DEVICE_COUNT 8U
+#endif
+
+/**
+ * Number of TX/RX queue control-block pairs in @ref uart_queue_pool. Only
+ * serial-mode ports take a pair, and a pair holds no ring storage (about
+ * 0.4 KiB), so the default lets every port open in serial mode.
+ */
+#ifndef UART_SERIAL_QUEUE_POOL_SIZE
+#define UART_SERIAL_QUEUE_POOL_SIZE UART_DEVICE_COUNT
+#endif
+
+/** Built-in ring size rounded up to a cache line, as carved from the arena. */
+#define UART_QUEUE_ARENA_RING_BYTES 1216U
+
+/**
+ * Bytes in @ref uart_queue_arena, the storage for rings opened without
+ * caller storage. Each such ring takes its capacity rounded up to a cache
+ * line; discrete ports and caller-storage rings take nothing. The default
+ * fits two built-in rings per pool pair; size it to the serial ports that
+ * use built-in rings (0 when all of them supply storage).
+ */
+#ifndef UART_QUEUE_ARENA_BYTES
+#define UART_QUEUE_ARENA_BYTES                                                 \
+    (UART_SERIAL_QUEUE_POOL_SIZE * 2U * UART_QUEUE_ARENA_RING_BYTES)
+#endif
 
 /** Number of UARTs represented in the read/write FIFO map. */
-#define UART_FIFO_UART_COUNT 8U
+#define UART_FIFO_UART_COUNT UART_DEVICE_COUNT
+
+/** Hardware/device FIFO capacity in bytes (a power of two). */
+#define UART_DEVICE_FIFO_SIZE_BYTES 256U
 
-/** Hardware/device FIFO capacity in bytes. */
-#define UART_DEVICE_FIFO_SIZE_BYTES 255U
+/** Mask that wraps a FIFO index into [0, UART_DEVICE_FIFO_SIZE_BYTES). */
+#define UART_DEVICE_FIFO_INDEX_MASK (UART_DEVICE_FIFO_SIZE_BYTES - 1U)
 
 typedef uint32_t channel_size_t;
 
@@ -36,18 +69,23 @@ typedef enum PORT_MODE
 } uart_port_mode_t;
 
 /**
- * @brief Read and write FIFO sets for multiple UARTs.
+ * @brief One emulated device FIFO.
+ *
+ * Cache-line aligned so FIFOs of different ports never share a line; the
+ * data fills whole lines and the index fields sit on their own line after
+ * it.
  */
 typedef struct UARTByteFifo
 {
     /** Fixed-size byte storage for the FIFO. */
+    SERIAL_QUEUE_ALIGNAS(SERIAL_QUEUE_CACHE_LINE_BYTES)
     uint8_t data[UART_DEVICE_FIFO_SIZE_BYTES];
     /** Index where next byte will be written. */
-    size_t head;
+    uint16_t head;
     /** Index where next byte will be read. */
-    size_t tail;
+    uint16_t tail;
     /** Number of bytes currently stored. */
-    size_t count;
+    uint16_t count;
 } uart_byte_fifo_t;
 
 /**
@@ -61,31 +99,99 @@ typedef struct UARTFifoMap
     uart_byte_fifo_t read_fifos[UART_FIFO_UART_COUNT];
 } uart_fifo_map_t;
 
+/**
+ * @brief TX/RX software queue control blocks bound to one serial-mode port.
+ */
+typedef struct UARTQueuePair
+{
+    /** Software transmit queue. */
+    serial_queue_t tx_queue;
+    /** Software receive queue. */
+    serial_queue_t rx_queue;
+} uart_queue_pair_t;
+
 /**
  * @brief Descriptor for one UART instance managed by the driver.
+ *
+ * Holds only the fields used on every write/read/poll; setup-only fields
+ * live in @ref uart_device_info_t. The fields are read-only once a port is
+ * open, so neighbouring devices share cache lines without false sharing.
  */
 typedef struct UARTDevice
 {
     /** Pointer to memory-mapped XR17C358 per-channel register map. */
     xr17c358_channel_register_map_t *registers;
-
-    /** Human-readable device name (for logs/config selection). */
-    const char *device_name;
-    /** Base address used to map/register this UART. */
-    uintptr_t uart_base_address;
+    /** Software transmit queue (serial mode only, otherwise NULL). */
+    serial_queue_t *tx_queue;
+    /** Software receive queue (serial mode only, otherwise NULL). */
+    serial_queue_t *rx_queue;
     /** Active mode for this UART slot. */
     uart_port_mode_t port_mode;
     /** True once this UART slot has been configured. */
     bool configured;
-    /** Software transmit queue. */
-    serial_queue_t tx_queue;
-    /** Software receive queue. */
-    serial_queue_t rx_queue;
 } uart_device_t;
 
+/**
+ * @brief Setup-only state for one UART slot, kept out of @ref uart_devices.
+ */
+typedef struct UARTDeviceInfo
+{
+    /** Human-readable device name (for logs/config selection). */
+    const char *device_name;
+    /** Base address used to map/register this UART. */
+    uintptr_t uart_base_address;
+    /** Baud rate last programmed by serial_port_configure (0 if never). */
+    uint32_t line_baud;
+    /** LCR value last programmed by serial_port_configure. */
+    uint8_t line_lcr;
+} uart_device_info_t;
+
 /** Global table of UART devices managed by the driver. */
 extern uart_device_t uart_devices[UART_DEVICE_COUNT];
-/** Global read/write FIFO map for 8 UART channels. */
+/** Setup-only state per UART slot, indexed like @ref uart_devices. */
+extern uart_device_info_t uart_device_info[UART_DEVICE_COUNT];
+/** Queue pairs handed out to serial-mode ports by @ref serial_port_init. */
+extern uart_queue_pair_t uart_queue_pool[UART_SERIAL_QUEUE_POOL_SIZE];
+#if UART_QUEUE_ARENA_BYTES > 0
+/** Ring storage carved out for serial-mode ports without caller storage. */
+extern uint8_t uart_queue_arena[UART_QUEUE_ARENA_BYTES];
+#endif
+/** Global read/write FIFO map, one FIFO pair per UART device slot. */
 extern uart_fifo_map_t uart_fifo_map;
 
+/**
+ * @brief Empty a FIFO.
+ *
+ * @param fifo FIFO to reset; NULL is ignored.
+ */
+void serial_driver_byte_fifo_reset(uart_byte_fifo_t *fifo);
+
+/**
+ * @brief Check whether a FIFO holds no bytes.
+ *
+ * @param fifo FIFO to check; NULL counts as empty.
+ * @return true when the FIFO is empty.
+ */
+bool serial_driver_byte_fifo_is_empty(const uart_byte_fifo_t *fifo);
+
+/**
+ * @brief Append bytes to a FIFO, one memcpy per wrap segment.
+ *
+ * @param fifo Destination FIFO.
+ * @param data Bytes to append.
+ * @param length Byte count; the caller keeps it within the free space.
+ */
+void serial_driver_byte_fifo_write(uart_byte_fifo_t *fifo, const uint8_t *data,
+                                   size_t length);
+
+/**
+ * @brief Remove bytes from a FIFO, one memcpy per wrap segment.
+ *
+ * @param fifo Source FIFO.
+ * @param data Receives the bytes.
+ * @param length Byte count; the caller keeps it within the stored count.
+ */
+void serial_driver_byte_fifo_read(uart_byte_fifo_t *fifo, uint8_t *data,
+                                  size_t length);
+
 #endif
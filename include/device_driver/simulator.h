@@ -0,0 +1,131 @@
+#ifndef SERIAL_DRIVER_SIMULATOR_H
+#define SERIAL_DRIVER_SIMULATOR_H
+
+#ifdef __cplusplus
+extern "C"
+{
+
+#endif
+    /**
+     * @file simulator.h
+     * @brief Virtual XR17V358 backend for running the driver without a card.
+     *
+     * The simulator installs itself through @ref serial_driver_hw_set_mapper
+     * and owns one register block per port. Each call to
+     * @ref serial_driver_sim_advance moves virtual time forward: every
+     * channel shifts bytes out of its write FIFO at the character rate its
+     * divisor, 4X/8X sampling and LCR select, and drops them into a receive
+     * FIFO. MCR loopback sends a channel's bytes (and RTS) back to itself;
+     * otherwise a channel connected with @ref serial_driver_sim_connect
+     * feeds its peer, as over a null-modem cable (TX to RX, RTS to CTS).
+     * Bytes sent on an unconnected channel are dropped.
+     *
+     * Only the software FIFO data path is modelled; the MMIO burst windows
+     * and the INT0-INT3 interrupt registers are left alone. The simulator
+     * shares @ref uart_fifo_map with the driver without locks, so call
+     * @ref serial_driver_sim_advance from the thread that polls the ports.
+     */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "device_driver/registers.h"
+
+/**
+ * Line rate assumed for a channel whose divisor has never been programmed
+ * (DLL and DLM both 0); such a channel also runs 8N1 whatever LCR says.
+ */
+#ifndef SERIAL_DRIVER_SIM_DEFAULT_BAUD
+#define SERIAL_DRIVER_SIM_DEFAULT_BAUD 115200UL
+#endif
+
+/** Peer value of a channel with no null-modem cable attached. */
+#define SERIAL_DRIVER_SIM_NO_PEER ((size_t)-1)
+
+    /**
+     * @brief Per-channel byte counters kept by the simulator.
+     */
+    typedef struct SerialDriverSimStats
+    {
+        /** Bytes shifted out of the channel's write FIFO. */
+        uint64_t tx_bytes;
+        /** Bytes stored in the channel's read FIFO. */
+        uint64_t rx_bytes;
+        /** Bytes that arrived while the read FIFO was full. */
+        uint64_t overruns;
+        /** Bytes sent with no loopback and no cable attached. */
+        uint64_t dropped;
+    } serial_driver_sim_stats_t;
+
+    /**
+     * @brief Reset the simulated card and install it as the hardware mapper.
+     *
+     * Clears every register block, FIFO, cable and counter. Ports opened
+     * afterwards are mapped onto the simulator; ports that were already open
+     * keep their registers.
+     *
+     * @return @ref UART_ERROR_NONE on success, otherwise an error code.
+     */
+    uart_error_t serial_driver_sim_install(void);
+
+    /**
+     * @brief Restore the built-in hardware mapper.
+     */
+    void serial_driver_sim_uninstall(void);
+
+    /**
+     * @brief Attach a null-modem cable between two channels.
+     *
+     * Any cable already on either channel is removed first.
+     *
+     * @param port_a First port index.
+     * @param port_b Second port index; must differ from @p port_a.
+     * @return @ref UART_ERROR_NONE on success,
+     * @ref UART_ERROR_INVALID_ARG for a bad or repeated port index.
+     */
+    uart_error_t serial_driver_sim_connect(size_t port_a, size_t port_b);
+
+    /**
+     * @brief Remove the cable from a channel (and from its peer).
+     *
+     * @param port_index Port index.
+     * @return @ref UART_ERROR_NONE on success, otherwise an error code.
+     */
+    uart_error_t serial_driver_sim_disconnect(size_t port_index);
+
+    /**
+     * @brief Move virtual time forward on every channel.
+     *
+     * A character leaves the write FIFO once a full frame time has passed
+     * since the previous one; a channel whose write FIFO runs empty goes
+     * idle, and the next byte it is given takes a full frame time again.
+     * With EFR auto-CTS set, a channel does not start a character while CTS
+     * is low. MSR CTS and LSR data-ready/overrun are updated on every call.
+     *
+     * @param elapsed_ns Virtual nanoseconds to simulate.
+     */
+    void serial_driver_sim_advance(uint64_t elapsed_ns);
+
+    /**
+     * @brief Time one character takes on a channel at its current settings.
+     *
+     * @param port_index Port index.
+     * @return Frame time in nanoseconds (rounded down), or 0 for a bad port.
+     */
+    uint64_t serial_driver_sim_char_time_ns(size_t port_index);
+
+    /**
+     * @brief Read a channel's counters.
+     *
+     * @param port_index Port index.
+     * @param out_stats Receives the counters.
+     * @return @ref UART_ERROR_NONE on success, otherwise an error code.
+     */
+    uart_error_t
+    serial_driver_sim_get_stats(size_t port_index,
+                                serial_driver_sim_stats_t *out_stats);
+#ifdef __cplusplus
+}
+#endif
+
+#endif
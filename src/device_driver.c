@@ -1,8 +1,224 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* pthread_attr_setaffinity_np */
+#endif
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L /* clock_gettime, pthread_condattr_setclock */
+#endif
+
 #include "device_driver/device_driver.h"
 #include "device_driver/device_driver_internal.h"
 
+#if SERIAL_DRIVER_BLOCKING
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+#if SERIAL_DRIVER_EVENTFD
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+_Static_assert(UART_DEVICE_COUNT <= 32U,
+               "pending-port masks hold one bit per descriptor slot");
+
+/* Cards whose channels have a device slot; card n holds ports 8n..8n+7. */
+#define SERIAL_DRIVER_CARD_COUNT                                               \
+    ((UART_DEVICE_COUNT + XR17V358_UART_CHANNEL_COUNT - 1U) /                  \
+     XR17V358_UART_CHANNEL_COUNT)
+
+/*
+ * One bit per descriptor slot with TX data queued / RX data in the device
+ * FIFO. Producers set bits; serial_driver_poll_all() takes whole masks and
+ * puts back bits for ports that still have work.
+ */
+static SERIAL_QUEUE_ATOMIC(uint32_t) serial_driver_tx_pending = 0U;
+static SERIAL_QUEUE_ATOMIC(uint32_t) serial_driver_rx_pending = 0U;
+
+static uint32_t serial_driver_entry_bit(const serial_descriptor_entry_t *entry)
+{
+    return (uint32_t)1U << (uint32_t)(entry - serial_descriptor_map);
+}
+
+static void serial_driver_mark_pending(SERIAL_QUEUE_ATOMIC(uint32_t) * mask,
+                                       const serial_descriptor_entry_t *entry)
+{
+    (void)atomic_fetch_or_explicit(mask, serial_driver_entry_bit(entry),
+                                   memory_order_release);
+}
+
+static size_t serial_driver_lowest_bit(uint32_t mask)
+{
+#if defined(__GNUC__)
+    return (size_t)__builtin_ctz(mask);
+#else
+    size_t index = 0U;
+
+    while ((mask & 1U) == 0U)
+    {
+        mask >>= 1U;
+        index += 1U;
+    }
+    return index;
+#endif
+}
+
+#if SERIAL_DRIVER_BLOCKING
+/*
+ * Threads parked in serial_driver_read_timeout() and
+ * serial_driver_write_timeout(), one slot per descriptor. A poll only takes
+ * the lock when the slot's waiter count is non-zero, so ports nobody waits on
+ * pay one atomic load per poll.
+ */
+typedef struct SerialDriverWaitSlot
+{
+    SERIAL_QUEUE_ALIGNAS(SERIAL_QUEUE_CACHE_LINE_BYTES)
+    SERIAL_QUEUE_ATOMIC(uint32_t) waiters;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} serial_driver_wait_slot_t;
+
+static serial_driver_wait_slot_t serial_driver_wait_slots[UART_DEVICE_COUNT];
+static pthread_once_t serial_driver_wait_once = PTHREAD_ONCE_INIT;
+
+static void serial_driver_wait_init(void)
+{
+    pthread_condattr_t attr;
+    size_t index = 0U;
+
+    (void)pthread_condattr_init(&attr);
+    (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    for (index = 0U; index < UART_DEVICE_COUNT; ++index)
+    {
+        (void)pthread_mutex_init(&serial_driver_wait_slots[index].lock, NULL);
+        (void)pthread_cond_init(&serial_driver_wait_slots[index].cond, &attr);
+    }
+    (void)pthread_condattr_destroy(&attr);
+}
+
+/* Called after a poll moved bytes; the fence orders the queue update before
+ * the waiter check, pairing with the one in serial_driver_wait_begin(). The
+ * acquire load also makes the waiter's one-time slot init visible here. */
+static void serial_driver_wake(const serial_descriptor_entry_t *entry)
+{
+    serial_driver_wait_slot_t *slot =
+        &serial_driver_wait_slots[entry - serial_descriptor_map];
+
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&slot->waiters, memory_order_acquire) == 0U)
+    {
+        return;
+    }
+
+    (void)pthread_mutex_lock(&slot->lock);
+    (void)pthread_cond_broadcast(&slot->cond);
+    (void)pthread_mutex_unlock(&slot->lock);
+}
+
+static serial_driver_wait_slot_t *
+serial_driver_wait_begin(const serial_descriptor_entry_t *entry,
+                         uint32_t timeout_ms, struct timespec *deadline)
+{
+    serial_driver_wait_slot_t *slot =
+        &serial_driver_wait_slots[entry - serial_descriptor_map];
+
+    (void)clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += (time_t)(timeout_ms / 1000U);
+    deadline->tv_nsec += (long)(timeout_ms % 1000U) * 1000000L;
+    if (deadline->tv_nsec >= 1000000000L)
+    {
+        deadline->tv_sec += 1;
+        deadline->tv_nsec -= 1000000000L;
+    }
+
+    (void)pthread_once(&serial_driver_wait_once, serial_driver_wait_init);
+    (void)atomic_fetch_add_explicit(&slot->waiters, 1U, memory_order_release);
+    atomic_thread_fence(memory_order_seq_cst);
+    (void)pthread_mutex_lock(&slot->lock);
+    return slot;
+}
+
+static void serial_driver_wait_end(serial_driver_wait_slot_t *slot)
+{
+    (void)pthread_mutex_unlock(&slot->lock);
+    (void)atomic_fetch_sub_explicit(&slot->waiters, 1U, memory_order_relaxed);
+}
+#endif
+
+#if SERIAL_DRIVER_EVENTFD
+/*
+ * Per-descriptor eventfd state. The poll path checks `armed` first, so ports
+ * without an eventfd pay one atomic load; `signalled` keeps a burst to one
+ * eventfd write until the event loop acknowledges it.
+ */
+typedef struct SerialDriverEventSlot
+{
+    SERIAL_QUEUE_ALIGNAS(SERIAL_QUEUE_CACHE_LINE_BYTES)
+    SERIAL_QUEUE_ATOMIC(bool) armed;
+    SERIAL_QUEUE_ATOMIC(bool) signalled;
+    int fd;
+    size_t rx_threshold;
+    size_t tx_low_water;
+} serial_driver_event_slot_t;
+
+static serial_driver_event_slot_t serial_driver_event_slots[UART_DEVICE_COUNT];
+
+static uint32_t
+serial_driver_event_levels(const serial_descriptor_entry_t *entry,
+                           const serial_driver_event_slot_t *slot)
+{
+    uint32_t events = 0U;
+
+    if (serial_queue_size(entry->uart_device->rx_queue) >= slot->rx_threshold)
+    {
+        events |= (uint32_t)SERIAL_EVENT_RX_READY;
+    }
+    if (serial_queue_size(entry->uart_device->tx_queue) <= slot->tx_low_water)
+    {
+        events |= (uint32_t)SERIAL_EVENT_TX_READY;
+    }
+    return events;
+}
+
+/* Called after a poll moved bytes; only the side that moved can signal. */
+static void serial_driver_signal_event(const serial_descriptor_entry_t *entry,
+                                       size_t tx_moved, size_t rx_moved)
+{
+    serial_driver_event_slot_t *slot =
+        &serial_driver_event_slots[entry - serial_descriptor_map];
+    const uint64_t increment = 1U;
+    uint32_t moved = 0U;
+
+    if (!atomic_load_explicit(&slot->armed, memory_order_acquire))
+    {
+        return;
+    }
+
+    moved = ((rx_moved > 0U) ? (uint32_t)SERIAL_EVENT_RX_READY : 0U) |
+            ((tx_moved > 0U) ? (uint32_t)SERIAL_EVENT_TX_READY : 0U);
+    if ((serial_driver_event_levels(entry, slot) & moved) == 0U ||
+        atomic_exchange_explicit(&slot->signalled, true, memory_order_acq_rel))
+    {
+        return;
+    }
+
+    (void)write(slot->fd, &increment, sizeof(increment));
+}
+#endif
+
 serial_descriptor_t serial_port_init(serial_ports_t port, uart_port_mode_t mode)
 {
+    serial_port_config_t config = {0};
+
+    config.mode = mode;
+    return serial_port_init_ex(port, &config);
+}
+
+serial_descriptor_t serial_port_init_ex(serial_ports_t port,
+                                        const serial_port_config_t *config)
+{
+    uart_port_mode_t mode = UART_PORT_MODE_SERIAL;
     size_t index = 0U;
     uart_device_t *uart_device = NULL;
     uart_error_t hw_map_error = UART_ERROR_NONE;
@@ -13,11 +229,12 @@ serial_descriptor_t serial_port_init(serial_ports_t port, uart_port_mode_t mode)
         return SERIAL_DESCRIPTOR_INVALID; /* LCOV_EXCL_LINE */
     }
 
-    if ((size_t)port >= UART_DEVICE_COUNT)
+    if ((size_t)port >= UART_DEVICE_COUNT || config == NULL)
     {
         return SERIAL_DESCRIPTOR_INVALID;
     }
 
+    mode = config->mode;
     if (mode != UART_PORT_MODE_SERIAL && mode != UART_PORT_MODE_DISCRETE)
     {
         return SERIAL_DESCRIPTOR_INVALID;
@@ -34,7 +251,8 @@ serial_descriptor_t serial_port_init(serial_ports_t port, uart_port_mode_t mode)
         }
     }
 
-    hw_map_error = serial_driver_hw_map_uart((size_t)port, uart_device);
+    hw_map_error = serial_driver_hw_map_uart((size_t)port, uart_device,
+                                             &uart_device_info[(size_t)port]);
     if (hw_map_error != UART_ERROR_NONE || uart_device->registers == NULL)
     {
         return SERIAL_DESCRIPTOR_INVALID;
@@ -47,27 +265,30 @@ serial_descriptor_t serial_port_init(serial_ports_t port, uart_port_mode_t mode)
             serial_descriptor_map[index].uart_device = uart_device;
             serial_descriptor_map[index].port_index = (uint32_t)port;
             serial_descriptor_map[index].mode = mode;
-            serial_descriptor_map[index].tx_input_staged_word = 0U;
-            serial_descriptor_map[index].tx_input_staged_word_bytes = 0U;
-            serial_descriptor_map[index].staged_word = 0U;
-            serial_descriptor_map[index].staged_word_bytes = 0U;
-            serial_descriptor_map[index].rx_staged_word = 0U;
-            serial_descriptor_map[index].rx_staged_word_bytes = 0U;
-            serial_descriptor_map[index].rx_output_staged_word = 0U;
-            serial_descriptor_map[index].rx_output_staged_word_bytes = 0U;
+            serial_descriptor_map[index].write_mode =
+                SERIAL_WRITE_MODE_SINGLE_PRODUCER;
+            serial_descriptor_map[index].poll_tx_budget =
+                UART_DEVICE_FIFO_SIZE_BYTES;
+            serial_descriptor_map[index].poll_rx_budget =
+                UART_DEVICE_FIFO_SIZE_BYTES;
+            serial_descriptor_map[index].poll_policy =
+                SERIAL_POLL_POLICY_TX_FIRST;
+            serial_descriptor_map[index].poll_rx_next = false;
+            serial_descriptor_map[index].data_path =
+                SERIAL_DATA_PATH_SOFTWARE_FIFO;
+            serial_descriptor_map[index].flow_control =
+                SERIAL_FLOW_CONTROL_NONE;
+            serial_descriptor_map[index].rx_throttled = false;
+            serial_descriptor_map[index].tx_xoff_held = false;
+            serial_descriptor_map[index].flow_char_pending = false;
             serial_descriptor_map[index].initialized = true;
 
             if (mode == UART_PORT_MODE_SERIAL &&
-                (serial_queue_init(
-                        &uart_device->tx_queue) != /* LCOV_EXCL_BR_LINE */
-                        UART_ERROR_NONE ||         /* LCOV_EXCL_BR_LINE */
-                    serial_queue_init(
-                        &uart_device->rx_queue) != /* LCOV_EXCL_BR_LINE */
-                        UART_ERROR_NONE))
+                serial_driver_bind_queues(uart_device, config) !=
+                    SERIAL_DRIVER_OK)
             {
-                serial_descriptor_map[index].initialized =
-                    false;                        /* LCOV_EXCL_LINE */
-                return SERIAL_DESCRIPTOR_INVALID; /* LCOV_EXCL_LINE */
+                serial_descriptor_map[index].initialized = false;
+                return SERIAL_DESCRIPTOR_INVALID;
             }
 
             uart_device->port_mode = mode;
@@ -79,22 +300,114 @@ serial_descriptor_t serial_port_init(serial_ports_t port, uart_port_mode_t mode)
     return SERIAL_DESCRIPTOR_INVALID; /* LCOV_EXCL_LINE */
 }
 
-serial_driver_error_t serial_driver_write(serial_descriptor_t descriptor,
-                                          const uint8_t *data, size_t length,
-                                          size_t *out_bytes_written)
+/*
+ * Divisor selection, usable both in constant expressions (the table below)
+ * and at runtime. Divisors are rounded and clamped to the 16-bit DLM:DLL
+ * range; a sampling rate fits when the resulting baud is within
+ * SERIAL_LINE_TOLERANCE_PERCENT of the request.
+ */
+#define SERIAL_LINE_TOLERANCE_PERCENT 3ULL
+#define SERIAL_LINE_RAW_DIVISOR(baud, sampling)                                \
+    (((unsigned long long)SERIAL_DRIVER_UART_CLOCK_HZ +                        \
+      ((unsigned long long)(sampling) * (baud)) / 2ULL) /                      \
+     ((unsigned long long)(sampling) * (baud)))
+#define SERIAL_LINE_DIVISOR(baud, sampling)                                    \
+    (SERIAL_LINE_RAW_DIVISOR(baud, sampling) == 0ULL                           \
+         ? 1ULL                                                                \
+     : SERIAL_LINE_RAW_DIVISOR(baud, sampling) > 0xFFFFULL                     \
+         ? 0xFFFFULL                                                           \
+         : SERIAL_LINE_RAW_DIVISOR(baud, sampling))
+#define SERIAL_LINE_ACTUAL(baud, sampling)                                     \
+    ((unsigned long long)SERIAL_DRIVER_UART_CLOCK_HZ /                         \
+     ((unsigned long long)(sampling) * SERIAL_LINE_DIVISOR(baud, sampling)))
+#define SERIAL_LINE_FITS(baud, sampling)                                       \
+    ((SERIAL_LINE_ACTUAL(baud, sampling) > (unsigned long long)(baud)          \
+          ? SERIAL_LINE_ACTUAL(baud, sampling) - (baud)                        \
+          : (unsigned long long)(baud) - SERIAL_LINE_ACTUAL(baud, sampling)) * \
+         100ULL <=                                                             \
+     SERIAL_LINE_TOLERANCE_PERCENT * (baud))
+#define SERIAL_LINE_SAMPLING(baud)                                             \
+    (SERIAL_LINE_FITS(baud, 16U)  ? 16U                                        \
+     : SERIAL_LINE_FITS(baud, 8U) ? 8U                                         \
+     : SERIAL_LINE_FITS(baud, 4U) ? 4U                                         \
+                                  : 0U)
+#define SERIAL_LINE_ENTRY(baud)                                                \
+    {(baud),                                                                   \
+     (uint16_t)SERIAL_LINE_DIVISOR(                                            \
+         baud, SERIAL_LINE_SAMPLING(baud) != 0U ? SERIAL_LINE_SAMPLING(baud)   \
+                                                : 16U),                        \
+     (uint8_t)SERIAL_LINE_SAMPLING(baud)}
+
+typedef struct SerialLineDivisor
 {
-    serial_descriptor_entry_t *entry = NULL;
-    size_t bytes_written = 0U;
-    uart_error_t queue_error = UART_ERROR_NONE;
-    serial_driver_error_t status = SERIAL_DRIVER_OK;
+    uint32_t baud;
+    uint16_t divisor;
+    /* 16, 8 or 4; 0 if the clock cannot reach the rate. */
+    uint8_t sampling;
+} serial_line_divisor_t;
 
-    if (out_bytes_written == NULL)
+static const serial_line_divisor_t serial_line_divisors[] = {
+    SERIAL_LINE_ENTRY(300U),     SERIAL_LINE_ENTRY(600U),
+    SERIAL_LINE_ENTRY(1200U),    SERIAL_LINE_ENTRY(2400U),
+    SERIAL_LINE_ENTRY(4800U),    SERIAL_LINE_ENTRY(9600U),
+    SERIAL_LINE_ENTRY(19200U),   SERIAL_LINE_ENTRY(38400U),
+    SERIAL_LINE_ENTRY(57600U),   SERIAL_LINE_ENTRY(115200U),
+    SERIAL_LINE_ENTRY(230400U),  SERIAL_LINE_ENTRY(460800U),
+    SERIAL_LINE_ENTRY(921600U),  SERIAL_LINE_ENTRY(1000000U),
+    SERIAL_LINE_ENTRY(1500000U), SERIAL_LINE_ENTRY(2000000U),
+    SERIAL_LINE_ENTRY(3000000U), SERIAL_LINE_ENTRY(4000000U),
+    SERIAL_LINE_ENTRY(6000000U), SERIAL_LINE_ENTRY(8000000U),
+};
+
+static serial_line_divisor_t serial_line_find_divisor(uint32_t baud)
+{
+    serial_line_divisor_t computed = {0U, 0U, 0U};
+    size_t index = 0U;
+
+    for (index = 0U;
+         index < sizeof(serial_line_divisors) / sizeof(serial_line_divisors[0]);
+         ++index)
     {
-        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+        if (serial_line_divisors[index].baud == baud)
+        {
+            return serial_line_divisors[index];
+        }
     }
-    *out_bytes_written = 0U;
 
-    if (length > 0U && data == NULL)
+    computed.baud = baud;
+    computed.sampling = (uint8_t)SERIAL_LINE_SAMPLING(baud);
+    if (computed.sampling != 0U)
+    {
+        computed.divisor =
+            (uint16_t)SERIAL_LINE_DIVISOR(baud, computed.sampling);
+    }
+    return computed;
+}
+
+serial_driver_error_t serial_port_configure(serial_descriptor_t descriptor,
+                                            uint32_t baud, uint8_t data_bits,
+                                            serial_parity_t parity,
+                                            serial_stop_bits_t stop_bits)
+{
+    static const uint8_t parity_bits[] = {
+        0U,
+        UART_LCR_PARITY_ENABLE_BIT,
+        UART_LCR_PARITY_ENABLE_BIT | UART_LCR_EVEN_PARITY_BIT,
+        UART_LCR_PARITY_ENABLE_BIT | UART_LCR_STICK_PARITY_BIT,
+        UART_LCR_PARITY_ENABLE_BIT | UART_LCR_STICK_PARITY_BIT |
+            UART_LCR_EVEN_PARITY_BIT,
+    };
+    serial_descriptor_entry_t *entry = NULL;
+    uart_device_info_t *device_info = NULL;
+    xr17c358_channel_register_map_t *registers = NULL;
+    serial_line_divisor_t line = {0U, 0U, 0U};
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+    uint8_t channel_bit = 0U;
+    uint8_t lcr = 0U;
+
+    if (baud == 0U || data_bits < 5U || data_bits > 8U ||
+        (size_t)parity >= sizeof(parity_bits) ||
+        (stop_bits != SERIAL_STOP_BITS_1 && stop_bits != SERIAL_STOP_BITS_2))
     {
         return SERIAL_DRIVER_ERROR_INVALID_ARG;
     }
@@ -106,78 +419,66 @@ serial_driver_error_t serial_driver_write(serial_descriptor_t descriptor,
         return status;
     }
 
-    while (bytes_written < length)
+    lcr = (uint8_t)(((uint32_t)data_bits - 5U) | parity_bits[parity]);
+    if (stop_bits == SERIAL_STOP_BITS_2)
     {
-        if (entry->tx_input_staged_word_bytes == sizeof(uint32_t))
-        {
-            queue_error = serial_queue_push(&entry->uart_device->tx_queue,
-                                            entry->tx_input_staged_word);
-            if (queue_error == UART_ERROR_FIFO_QUEUE_FULL)
-            {
-                break;
-            }
-            if (queue_error != UART_ERROR_NONE)
-            {
-                return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
-            }
-
-            entry->tx_input_staged_word = 0U;
-            entry->tx_input_staged_word_bytes = 0U;
-            continue;
-        }
-
-        entry->tx_input_staged_word |=
-            ((uint32_t)data[bytes_written])
-            << (8U * entry->tx_input_staged_word_bytes);
-        entry->tx_input_staged_word_bytes += 1U;
-        bytes_written += 1U;
+        lcr |= UART_LCR_STOP_BITS_BIT;
     }
 
-    if (entry->tx_input_staged_word_bytes == sizeof(uint32_t))
+    registers = entry->uart_device->registers;
+    device_info = &uart_device_info[entry->port_index];
+    if (device_info->line_baud == baud)
     {
-        queue_error = serial_queue_push(&entry->uart_device->tx_queue,
-                                        entry->tx_input_staged_word);
-        if (queue_error == UART_ERROR_NONE)
-        {
-            entry->tx_input_staged_word = 0U;
-            entry->tx_input_staged_word_bytes = 0U;
-        }
-        else if (queue_error == UART_ERROR_FIFO_QUEUE_FULL)
-        {
-            if (bytes_written < length)
-            {
-                *out_bytes_written = bytes_written;
-                return SERIAL_DRIVER_ERROR_TX_FULL;
-            }
-        }
-        else
+        if (device_info->line_lcr != lcr)
         {
-            return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+            registers->uart.lcr = lcr;
+            device_info->line_lcr = lcr;
         }
+        return SERIAL_DRIVER_OK;
+    }
+
+    line = serial_line_find_divisor(baud);
+    if (line.sampling == 0U)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
     }
 
-    *out_bytes_written = bytes_written;
+    channel_bit = (uint8_t)(1U << (entry->port_index %
+                                  XR17V358_UART_CHANNEL_COUNT));
+    registers->device_config.generic.mode_8x =
+        (line.sampling == 8U)
+            ? (uint8_t)(registers->device_config.generic.mode_8x | channel_bit)
+            : (uint8_t)(registers->device_config.generic.mode_8x &
+                        ~channel_bit);
+    registers->device_config.generic.mode_4x =
+        (line.sampling == 4U)
+            ? (uint8_t)(registers->device_config.generic.mode_4x | channel_bit)
+            : (uint8_t)(registers->device_config.generic.mode_4x &
+                        ~channel_bit);
 
-    return (bytes_written == length)
-               ? SERIAL_DRIVER_OK
-               : SERIAL_DRIVER_ERROR_TX_FULL; /* LCOV_EXCL_BR_LINE */
+    registers->uart.lcr = (uint8_t)(lcr | UART_LCR_DLAB_BIT);
+    registers->uart.data.dll = (uint8_t)(line.divisor & 0xFFU);
+    registers->uart.interrupt_enable.dlm = (uint8_t)(line.divisor >> 8U);
+    registers->uart.lcr = lcr;
+
+    device_info->line_baud = baud;
+    device_info->line_lcr = lcr;
+    return SERIAL_DRIVER_OK;
 }
 
-serial_driver_error_t serial_driver_read(serial_descriptor_t descriptor,
-                                         uint8_t *data, size_t length,
-                                         size_t *out_bytes_read)
+serial_driver_error_t serial_driver_write(serial_descriptor_t descriptor,
+                                          const uint8_t *data, size_t length,
+                                          size_t *out_bytes_written)
 {
     serial_descriptor_entry_t *entry = NULL;
-    size_t bytes_read = 0U;
-    uint32_t word = 0U;
     uart_error_t queue_error = UART_ERROR_NONE;
     serial_driver_error_t status = SERIAL_DRIVER_OK;
 
-    if (out_bytes_read == NULL)
+    if (out_bytes_written == NULL)
     {
         return SERIAL_DRIVER_ERROR_INVALID_ARG;
     }
-    *out_bytes_read = 0U;
+    *out_bytes_written = 0U;
 
     if (length > 0U && data == NULL)
     {
@@ -191,143 +492,1862 @@ serial_driver_error_t serial_driver_read(serial_descriptor_t descriptor,
         return status;
     }
 
-    while (bytes_read < length)
+    if (entry->write_mode == SERIAL_WRITE_MODE_MULTI_PRODUCER)
     {
-        if (entry->rx_output_staged_word_bytes > 0U)
-        {
-            data[bytes_read] = (uint8_t)(entry->rx_output_staged_word & 0xFFU);
-            entry->rx_output_staged_word >>= 8U;
-            entry->rx_output_staged_word_bytes -= 1U;
-            bytes_read += 1U;
-            continue;
-        }
-
-        queue_error = serial_queue_pop(&entry->uart_device->rx_queue, &word);
+        queue_error = serial_queue_push_bytes_mp(entry->uart_device->tx_queue,
+                                                 data, length);
         if (queue_error == UART_ERROR_NONE)
         {
-            entry->rx_output_staged_word = word;
-            entry->rx_output_staged_word_bytes = sizeof(uint32_t);
-            continue;
-        }
-
-        if (queue_error == UART_ERROR_FIFO_QUEUE_EMPTY)
-        {
-            if (entry->rx_staged_word_bytes > 0U)
+            *out_bytes_written = length;
+            if (length > 0U)
             {
-                data[bytes_read] = (uint8_t)(entry->rx_staged_word & 0xFFU);
-                entry->rx_staged_word >>= 8U;
-                entry->rx_staged_word_bytes -= 1U;
-                bytes_read += 1U;
-                continue;
+                serial_driver_mark_pending(&serial_driver_tx_pending, entry);
             }
-            break;
+            return SERIAL_DRIVER_OK;
+        }
+        if (queue_error == UART_ERROR_FIFO_QUEUE_FULL)
+        {
+            return SERIAL_DRIVER_ERROR_TX_FULL;
         }
+        return (queue_error == UART_ERROR_INVALID_ARG)
+                   ? SERIAL_DRIVER_ERROR_INVALID_ARG
+                   : SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+    }
 
+    queue_error = serial_queue_push_bytes(entry->uart_device->tx_queue, data,
+                                          length, out_bytes_written);
+    if (queue_error != UART_ERROR_NONE &&
+        queue_error != UART_ERROR_FIFO_QUEUE_FULL)
+    {
         return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
     }
 
-    *out_bytes_read = bytes_read;
-    if (bytes_read == 0U && length > 0U)
+    if (*out_bytes_written > 0U)
     {
-        return SERIAL_DRIVER_ERROR_RX_EMPTY;
+        serial_driver_mark_pending(&serial_driver_tx_pending, entry);
     }
-
-    return SERIAL_DRIVER_OK;
+    return (*out_bytes_written == length) ? SERIAL_DRIVER_OK
+                                          : SERIAL_DRIVER_ERROR_TX_FULL;
 }
 
-serial_driver_error_t serial_driver_poll(serial_descriptor_t descriptor,
-                                         size_t max_tx_bytes,
-                                         size_t max_rx_bytes,
-                                         size_t *out_tx_bytes_transmitted,
-                                         size_t *out_rx_bytes_received)
+/* Resolve a serial entry whose TX ring is driven by a single producer. */
+static serial_driver_error_t
+serial_driver_get_sp_writer(serial_descriptor_t descriptor,
+                            serial_descriptor_entry_t **out_entry)
 {
-    serial_descriptor_entry_t *entry = NULL;
-    serial_driver_error_t status = SERIAL_DRIVER_OK;
+    serial_driver_error_t status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL,
+                                     out_entry);
 
-    if (out_tx_bytes_transmitted == NULL || out_rx_bytes_received == NULL)
+    if (status == SERIAL_DRIVER_OK &&
+        (*out_entry)->write_mode != SERIAL_WRITE_MODE_SINGLE_PRODUCER)
     {
-        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+        return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
     }
 
-    *out_tx_bytes_transmitted = 0U;
-    *out_rx_bytes_received = 0U;
+    return status;
+}
 
-    status =
-        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
-    if (status != SERIAL_DRIVER_OK)
+serial_driver_error_t
+serial_driver_write_reserve(serial_descriptor_t descriptor, size_t min_length,
+                            serial_span_t *out_first, serial_span_t *out_second)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    uart_error_t queue_error = UART_ERROR_NONE;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    if (out_first == NULL || out_second == NULL)
     {
-        return status;
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
     }
 
-    status = serial_driver_transmit_to_device_fifo(entry, max_tx_bytes,
-                                                   out_tx_bytes_transmitted);
+    status = serial_driver_get_sp_writer(descriptor, &entry);
     if (status != SERIAL_DRIVER_OK)
     {
+        out_first->data = NULL;
+        out_first->length = 0U;
+        out_second->data = NULL;
+        out_second->length = 0U;
         return status;
     }
 
-    if (entry->staged_word_bytes != 0U ||
-        entry->tx_input_staged_word_bytes != 0U || /* LCOV_EXCL_BR_LINE */
-        serial_queue_size(&entry->uart_device->tx_queue) != 0U)
+    queue_error = serial_queue_reserve_bytes(entry->uart_device->tx_queue,
+                                             min_length, out_first, out_second);
+    if (queue_error == UART_ERROR_NONE)
     {
         return SERIAL_DRIVER_OK;
     }
 
-    return serial_driver_receive_from_device_fifo(entry, max_rx_bytes,
-                                                  out_rx_bytes_received);
+    return (queue_error == UART_ERROR_FIFO_QUEUE_FULL)
+               ? SERIAL_DRIVER_ERROR_TX_FULL
+               : SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
 }
 
-static serial_driver_error_t
-serial_driver_set_mcr_bit(serial_descriptor_t descriptor, uart_port_mode_t mode,
-                          uint8_t bit_mask, bool enable)
+serial_driver_error_t serial_driver_write_commit(serial_descriptor_t descriptor,
+                                                 size_t length)
 {
     serial_descriptor_entry_t *entry = NULL;
-    volatile uint8_t *mcr = NULL;
+    uart_error_t queue_error = UART_ERROR_NONE;
     serial_driver_error_t status = SERIAL_DRIVER_OK;
 
-    status = serial_driver_get_mode_entry(descriptor, mode, &entry);
+    status = serial_driver_get_sp_writer(descriptor, &entry);
     if (status != SERIAL_DRIVER_OK)
     {
         return status;
     }
 
-    mcr = &entry->uart_device->registers->uart.mcr;
-    if (enable)
-    {
-        *mcr |= bit_mask;
-    }
-    else
+    queue_error =
+        serial_queue_commit_bytes(entry->uart_device->tx_queue, length);
+    if (queue_error == UART_ERROR_NONE)
     {
-        *mcr &= (uint8_t)(~bit_mask);
+        if (length > 0U)
+        {
+            serial_driver_mark_pending(&serial_driver_tx_pending, entry);
+        }
+        return SERIAL_DRIVER_OK;
     }
 
-    return SERIAL_DRIVER_OK;
+    return (queue_error == UART_ERROR_INVALID_ARG)
+               ? SERIAL_DRIVER_ERROR_INVALID_ARG
+               : SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
 }
 
-serial_driver_error_t
-serial_driver_enable_loopback(serial_descriptor_t descriptor)
+/*
+ * Copy up to @p limit bytes from one span list to another, walking both in
+ * order with one memcpy per overlapping piece. Returns the bytes copied.
+ */
+static size_t serial_driver_copy_spans(const serial_span_t *dst,
+                                       size_t dst_count,
+                                       const serial_const_span_t *src,
+                                       size_t src_count, size_t limit)
 {
-    return serial_driver_set_mcr_bit(descriptor, UART_PORT_MODE_SERIAL,
-                                     UART_MCR_LOOPBACK_BIT, true);
+    size_t dst_index = 0U;
+    size_t src_index = 0U;
+    size_t dst_offset = 0U;
+    size_t src_offset = 0U;
+    size_t copied = 0U;
+
+    while (copied < limit && dst_index < dst_count && src_index < src_count)
+    {
+        size_t chunk = dst[dst_index].length - dst_offset;
+
+        if (chunk > src[src_index].length - src_offset)
+        {
+            chunk = src[src_index].length - src_offset;
+        }
+        if (chunk > limit - copied)
+        {
+            chunk = limit - copied;
+        }
+        if (chunk > 0U)
+        {
+            memcpy(&dst[dst_index].data[dst_offset],
+                   &src[src_index].data[src_offset], chunk);
+        }
+
+        copied += chunk;
+        dst_offset += chunk;
+        src_offset += chunk;
+        if (dst_offset == dst[dst_index].length)
+        {
+            dst_index += 1U;
+            dst_offset = 0U;
+        }
+        if (src_offset == src[src_index].length)
+        {
+            src_index += 1U;
+            src_offset = 0U;
+        }
+    }
+
+    return copied;
 }
 
-serial_driver_error_t
-serial_driver_disable_loopback(serial_descriptor_t descriptor)
+/* Add one segment to a scatter-gather total; false if invalid or too large. */
+static bool serial_driver_add_segment(const void *data, size_t length,
+                                      size_t *total)
 {
-    return serial_driver_set_mcr_bit(descriptor, UART_PORT_MODE_SERIAL,
-                                     UART_MCR_LOOPBACK_BIT, false);
+    if ((length > 0U && data == NULL) || length > SIZE_MAX - *total)
+    {
+        return false;
+    }
+
+    *total += length;
+    return true;
 }
 
 serial_driver_error_t
-serial_driver_enable_discrete(serial_descriptor_t descriptor)
+serial_driver_write_timeout(serial_descriptor_t descriptor, const uint8_t *data,
+                            size_t length, size_t *out_bytes_written,
+                            uint32_t timeout_ms)
 {
-    return serial_driver_set_mcr_bit(descriptor, UART_PORT_MODE_DISCRETE,
-                                     UART_MCR_DISCRETE_LINE_BIT, true);
+#if SERIAL_DRIVER_BLOCKING
+    serial_descriptor_entry_t *entry = NULL;
+    serial_driver_wait_slot_t *slot = NULL;
+    struct timespec deadline;
+    size_t written = 0U;
+    size_t chunk = 0U;
+    int wait_error = 0;
+    serial_driver_error_t status =
+        serial_driver_write(descriptor, data, length, out_bytes_written);
+
+    if (status != SERIAL_DRIVER_ERROR_TX_FULL)
+    {
+        return status;
+    }
+    if (timeout_ms == 0U)
+    {
+        return SERIAL_DRIVER_ERROR_TIMEOUT;
+    }
+
+    written = *out_bytes_written;
+    (void)serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL,
+                                       &entry);
+    slot = serial_driver_wait_begin(entry, timeout_ms, &deadline);
+    for (;;)
+    {
+        status = serial_driver_write(descriptor, &data[written],
+                                     length - written, &chunk);
+        written += chunk;
+        if (status != SERIAL_DRIVER_ERROR_TX_FULL)
+        {
+            break;
+        }
+        if (wait_error == ETIMEDOUT)
+        {
+            status = SERIAL_DRIVER_ERROR_TIMEOUT;
+            break;
+        }
+        wait_error =
+            pthread_cond_timedwait(&slot->cond, &slot->lock, &deadline);
+    }
+    serial_driver_wait_end(slot);
+
+    *out_bytes_written = written;
+    return status;
+#else
+    (void)descriptor;
+    (void)data;
+    (void)length;
+    (void)timeout_ms;
+    if (out_bytes_written != NULL)
+    {
+        *out_bytes_written = 0U;
+    }
+    return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+#endif
 }
 
-serial_driver_error_t
-serial_driver_disable_discrete(serial_descriptor_t descriptor)
+serial_driver_error_t serial_driver_writev(serial_descriptor_t descriptor,
+                                           const serial_const_span_t *iov,
+                                           size_t iovcnt,
+                                           size_t *out_bytes_written)
 {
-    return serial_driver_set_mcr_bit(descriptor, UART_PORT_MODE_DISCRETE,
-                                     UART_MCR_DISCRETE_LINE_BIT, false);
+    serial_descriptor_entry_t *entry = NULL;
+    serial_span_t spans[2] = {{NULL, 0U}, {NULL, 0U}};
+    uart_error_t queue_error = UART_ERROR_NONE;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+    size_t total = 0U;
+    size_t index = 0U;
+
+    if (out_bytes_written == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    *out_bytes_written = 0U;
+
+    if (iovcnt > 0U && iov == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    for (index = 0U; index < iovcnt; ++index)
+    {
+        if (!serial_driver_add_segment(iov[index].data, iov[index].length,
+                                       &total))
+        {
+            return SERIAL_DRIVER_ERROR_INVALID_ARG;
+        }
+    }
+
+    status = serial_driver_get_sp_writer(descriptor, &entry);
+    if (status != SERIAL_DRIVER_OK || total == 0U)
+    {
+        return status;
+    }
+
+    queue_error = serial_queue_reserve_bytes(entry->uart_device->tx_queue,
+                                             total, &spans[0], &spans[1]);
+    if (queue_error == UART_ERROR_FIFO_QUEUE_FULL)
+    {
+        return SERIAL_DRIVER_ERROR_TX_FULL;
+    }
+    if (queue_error != UART_ERROR_NONE)
+    {
+        return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+    }
+
+    (void)serial_driver_copy_spans(spans, 2U, iov, iovcnt, total);
+    (void)serial_queue_commit_bytes(entry->uart_device->tx_queue, total);
+    serial_driver_mark_pending(&serial_driver_tx_pending, entry);
+    *out_bytes_written = total;
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t
+serial_driver_set_write_mode(serial_descriptor_t descriptor,
+                             serial_write_mode_t mode)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    if (mode != SERIAL_WRITE_MODE_SINGLE_PRODUCER &&
+        mode != SERIAL_WRITE_MODE_MULTI_PRODUCER)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    if (mode == SERIAL_WRITE_MODE_MULTI_PRODUCER &&
+        serial_queue_sync_producers(entry->uart_device->tx_queue) !=
+            UART_ERROR_NONE)
+    {
+        return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+    }
+
+    entry->write_mode = mode;
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t serial_driver_read(serial_descriptor_t descriptor,
+                                         uint8_t *data, size_t length,
+                                         size_t *out_bytes_read)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    uart_error_t queue_error = UART_ERROR_NONE;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    if (out_bytes_read == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    *out_bytes_read = 0U;
+
+    if (length > 0U && data == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    queue_error = serial_queue_pop_bytes(entry->uart_device->rx_queue, data,
+                                         length, out_bytes_read);
+    if (queue_error == UART_ERROR_FIFO_QUEUE_EMPTY)
+    {
+        return SERIAL_DRIVER_ERROR_RX_EMPTY;
+    }
+    if (queue_error != UART_ERROR_NONE)
+    {
+        return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+    }
+
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t serial_driver_read_peek(serial_descriptor_t descriptor,
+                                              serial_const_span_t *out_first,
+                                              serial_const_span_t *out_second)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    uart_error_t queue_error = UART_ERROR_NONE;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    if (out_first == NULL || out_second == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    out_first->data = NULL;
+    out_first->length = 0U;
+    out_second->data = NULL;
+    out_second->length = 0U;
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    queue_error = serial_queue_peek_bytes(entry->uart_device->rx_queue,
+                                          out_first, out_second);
+    if (queue_error == UART_ERROR_FIFO_QUEUE_EMPTY)
+    {
+        return SERIAL_DRIVER_ERROR_RX_EMPTY;
+    }
+    if (queue_error != UART_ERROR_NONE)
+    {
+        return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+    }
+
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t serial_driver_read_timeout(serial_descriptor_t descriptor,
+                                                 uint8_t *data, size_t length,
+                                                 size_t *out_bytes_read,
+                                                 uint32_t timeout_ms)
+{
+#if SERIAL_DRIVER_BLOCKING
+    serial_descriptor_entry_t *entry = NULL;
+    serial_driver_wait_slot_t *slot = NULL;
+    struct timespec deadline;
+    int wait_error = 0;
+    serial_driver_error_t status =
+        serial_driver_read(descriptor, data, length, out_bytes_read);
+
+    if (status != SERIAL_DRIVER_ERROR_RX_EMPTY)
+    {
+        return status;
+    }
+    if (timeout_ms == 0U)
+    {
+        return SERIAL_DRIVER_ERROR_TIMEOUT;
+    }
+
+    (void)serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL,
+                                       &entry);
+    slot = serial_driver_wait_begin(entry, timeout_ms, &deadline);
+    for (;;)
+    {
+        status = serial_driver_read(descriptor, data, length, out_bytes_read);
+        if (status != SERIAL_DRIVER_ERROR_RX_EMPTY)
+        {
+            break;
+        }
+        if (wait_error == ETIMEDOUT)
+        {
+            status = SERIAL_DRIVER_ERROR_TIMEOUT;
+            break;
+        }
+        wait_error =
+            pthread_cond_timedwait(&slot->cond, &slot->lock, &deadline);
+    }
+    serial_driver_wait_end(slot);
+    return status;
+#else
+    (void)descriptor;
+    (void)data;
+    (void)length;
+    (void)timeout_ms;
+    if (out_bytes_read != NULL)
+    {
+        *out_bytes_read = 0U;
+    }
+    return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+#endif
+}
+
+serial_driver_error_t serial_driver_readv(serial_descriptor_t descriptor,
+                                          const serial_span_t *iov,
+                                          size_t iovcnt, size_t *out_bytes_read)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    serial_const_span_t spans[2] = {{NULL, 0U}, {NULL, 0U}};
+    uart_error_t queue_error = UART_ERROR_NONE;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+    size_t total = 0U;
+    size_t index = 0U;
+
+    if (out_bytes_read == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    *out_bytes_read = 0U;
+
+    if (iovcnt > 0U && iov == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    for (index = 0U; index < iovcnt; ++index)
+    {
+        if (!serial_driver_add_segment(iov[index].data, iov[index].length,
+                                       &total))
+        {
+            return SERIAL_DRIVER_ERROR_INVALID_ARG;
+        }
+    }
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    queue_error = serial_queue_peek_bytes(entry->uart_device->rx_queue,
+                                          &spans[0], &spans[1]);
+    if (queue_error == UART_ERROR_FIFO_QUEUE_EMPTY)
+    {
+        return SERIAL_DRIVER_ERROR_RX_EMPTY;
+    }
+    if (queue_error != UART_ERROR_NONE)
+    {
+        return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+    }
+
+    *out_bytes_read = serial_driver_copy_spans(iov, iovcnt, spans, 2U, total);
+    (void)serial_queue_consume_bytes(entry->uart_device->rx_queue,
+                                     *out_bytes_read);
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t serial_driver_read_consume(serial_descriptor_t descriptor,
+                                                 size_t length)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    uart_error_t queue_error = UART_ERROR_NONE;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    queue_error =
+        serial_queue_consume_bytes(entry->uart_device->rx_queue, length);
+    if (queue_error == UART_ERROR_NONE)
+    {
+        return SERIAL_DRIVER_OK;
+    }
+
+    return (queue_error == UART_ERROR_INVALID_ARG)
+               ? SERIAL_DRIVER_ERROR_INVALID_ARG
+               : SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+}
+
+/*
+ * Software flow control: hold the peer off once the RX queue reaches the
+ * high-water mark and release it at the low-water mark. RTS mode writes
+ * MCR only on a change; XON/XOFF mode queues the matching character, or
+ * cancels one still unsent, since the peer never saw it.
+ */
+static void serial_driver_flow_update(serial_descriptor_entry_t *entry)
+{
+    volatile uint8_t *mcr = NULL;
+    size_t used = 0U;
+    bool throttle = false;
+
+    if (entry->flow_control != SERIAL_FLOW_CONTROL_SW_RTS_CTS &&
+        entry->flow_control != SERIAL_FLOW_CONTROL_SW_XON_XOFF)
+    {
+        return;
+    }
+
+    used = serial_queue_size(entry->uart_device->rx_queue);
+    if (!entry->rx_throttled && used >= entry->rts_high_water)
+    {
+        throttle = true;
+    }
+    else if (!(entry->rx_throttled && used <= entry->rts_low_water))
+    {
+        return;
+    }
+
+    entry->rx_throttled = throttle;
+    if (entry->flow_control == SERIAL_FLOW_CONTROL_SW_XON_XOFF)
+    {
+        entry->flow_char_pending = !entry->flow_char_pending;
+        return;
+    }
+    mcr = &entry->uart_device->registers->uart.mcr;
+    if (throttle)
+    {
+        *mcr &= (uint8_t)(~UART_MCR_RTS_BIT);
+    }
+    else
+    {
+        *mcr |= UART_MCR_RTS_BIT;
+    }
+}
+
+/* Move TX and/or RX for one entry according to its poll policy. */
+static serial_driver_error_t
+serial_driver_move_entry(serial_descriptor_entry_t *entry,
+                         size_t max_tx_bytes, size_t max_rx_bytes,
+                         size_t *out_tx_bytes_transmitted,
+                         size_t *out_rx_bytes_received)
+{
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+    bool rx_first = false;
+
+    if (entry->poll_policy == SERIAL_POLL_POLICY_TX_FIRST)
+    {
+        status = serial_driver_transmit_to_device_fifo(
+            entry, max_tx_bytes, out_tx_bytes_transmitted);
+        /* TX held by flow control must not starve RX, which may carry the
+         * XON that releases it. */
+        if (status != SERIAL_DRIVER_OK ||
+            (serial_queue_size(entry->uart_device->tx_queue) != 0U &&
+             !serial_driver_flow_tx_held(entry)))
+        {
+            return status;
+        }
+
+        return serial_driver_receive_from_device_fifo(entry, max_rx_bytes,
+                                                      out_rx_bytes_received);
+    }
+
+    rx_first = entry->poll_policy == SERIAL_POLL_POLICY_RX_PRIORITY ||
+               entry->poll_rx_next;
+    entry->poll_rx_next = !entry->poll_rx_next;
+
+    if (rx_first)
+    {
+        status = serial_driver_receive_from_device_fifo(entry, max_rx_bytes,
+                                                        out_rx_bytes_received);
+    }
+    if (status == SERIAL_DRIVER_OK)
+    {
+        status = serial_driver_transmit_to_device_fifo(
+            entry, max_tx_bytes, out_tx_bytes_transmitted);
+    }
+    if (status == SERIAL_DRIVER_OK && !rx_first)
+    {
+        status = serial_driver_receive_from_device_fifo(entry, max_rx_bytes,
+                                                        out_rx_bytes_received);
+    }
+
+    return status;
+}
+
+/* One poll of an entry: move data, then let software flow control follow
+ * the RX queue fill and send any XON/XOFF that became due. A throttled
+ * port stays RX-pending, since no interrupt will arrive to get the peer
+ * released again. */
+static serial_driver_error_t
+serial_driver_service_entry(serial_descriptor_entry_t *entry,
+                            size_t max_tx_bytes, size_t max_rx_bytes,
+                            size_t *out_tx_bytes_transmitted,
+                            size_t *out_rx_bytes_received)
+{
+    const serial_driver_error_t status = serial_driver_move_entry(
+        entry, max_tx_bytes, max_rx_bytes, out_tx_bytes_transmitted,
+        out_rx_bytes_received);
+
+    serial_driver_flow_update(entry);
+    serial_driver_flow_send_char(entry);
+    if (entry->rx_throttled)
+    {
+        serial_driver_mark_pending(&serial_driver_rx_pending, entry);
+    }
+    if (*out_tx_bytes_transmitted > 0U || *out_rx_bytes_received > 0U)
+    {
+#if SERIAL_DRIVER_BLOCKING
+        serial_driver_wake(entry);
+#endif
+#if SERIAL_DRIVER_EVENTFD
+        serial_driver_signal_event(entry, *out_tx_bytes_transmitted,
+                                   *out_rx_bytes_received);
+#endif
+    }
+    return status;
+}
+
+/* Whether a port may still have RX data after a poll received rx_bytes.
+ * RXCNT is not re-read; a burst that moved bytes may have left more behind,
+ * so the next poll checks. */
+static bool serial_driver_rx_left(const serial_descriptor_entry_t *entry,
+                                  size_t rx_bytes)
+{
+    if (entry->data_path != SERIAL_DATA_PATH_SOFTWARE_FIFO)
+    {
+        return rx_bytes != 0U;
+    }
+    return !serial_driver_byte_fifo_is_empty(
+        &uart_fifo_map.read_fifos[(size_t)entry->port_index]);
+}
+
+serial_driver_error_t serial_driver_poll(serial_descriptor_t descriptor,
+                                         size_t max_tx_bytes,
+                                         size_t max_rx_bytes,
+                                         size_t *out_tx_bytes_transmitted,
+                                         size_t *out_rx_bytes_received)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    if (out_tx_bytes_transmitted == NULL || out_rx_bytes_received == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    *out_tx_bytes_transmitted = 0U;
+    *out_rx_bytes_received = 0U;
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    return serial_driver_service_entry(entry, max_tx_bytes, max_rx_bytes,
+                                       out_tx_bytes_transmitted,
+                                       out_rx_bytes_received);
+}
+
+serial_driver_error_t
+serial_driver_set_poll_policy(serial_descriptor_t descriptor,
+                              serial_poll_policy_t policy)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    if (policy != SERIAL_POLL_POLICY_TX_FIRST &&
+        policy != SERIAL_POLL_POLICY_ALTERNATE &&
+        policy != SERIAL_POLL_POLICY_RX_PRIORITY)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    entry->poll_policy = policy;
+    entry->poll_rx_next = false;
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t
+serial_driver_set_poll_budget(serial_descriptor_t descriptor,
+                              size_t max_tx_bytes, size_t max_rx_bytes)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    entry->poll_tx_budget = max_tx_bytes;
+    entry->poll_rx_budget = max_rx_bytes;
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t
+serial_driver_set_data_path(serial_descriptor_t descriptor,
+                            serial_data_path_t path)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    if (path != SERIAL_DATA_PATH_SOFTWARE_FIFO &&
+        path != SERIAL_DATA_PATH_MMIO_BURST &&
+        path != SERIAL_DATA_PATH_MMIO_BURST_WITH_STATUS)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    entry->data_path = path;
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t
+serial_driver_set_fifo_triggers(serial_descriptor_t descriptor,
+                                uint8_t tx_trigger, uint8_t rx_trigger)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    xr17c358_channel_register_map_t *registers = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+    uint8_t efr = 0U;
+
+    if (rx_trigger == 0U)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    registers = entry->uart_device->registers;
+    efr = registers->uart.efr;
+    registers->uart.efr = (uint8_t)(efr | XR17V358_EFR_ENHANCED_BIT);
+    registers->uart.fctr =
+        (uint8_t)((registers->uart.fctr & ~XR17V358_FCTR_TRIGGER_TABLE_MASK) |
+                  XR17V358_FCTR_TRIGGER_TABLE_D);
+    registers->uart.txcnt_or_txtrg.txtrg = tx_trigger;
+    registers->uart.rxcnt_or_rxtrg.rxtrg = rx_trigger;
+    registers->uart.efr = efr;
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t
+serial_driver_apply_fifo_profile(serial_descriptor_t descriptor,
+                                 serial_fifo_profile_t profile)
+{
+    static const struct
+    {
+        uint8_t tx_trigger;
+        uint8_t rx_trigger;
+        size_t poll_budget;
+    } profiles[] = {
+        /* SERIAL_FIFO_PROFILE_LATENCY */
+        {128U, 8U, 64U},
+        /* SERIAL_FIFO_PROFILE_THROUGHPUT */
+        {32U, 224U, XR17V358_FIFO_DEPTH},
+    };
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    if ((size_t)profile >= sizeof(profiles) / sizeof(profiles[0]))
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    status = serial_driver_set_fifo_triggers(
+        descriptor, profiles[profile].tx_trigger, profiles[profile].rx_trigger);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    return serial_driver_set_poll_budget(descriptor,
+                                         profiles[profile].poll_budget,
+                                         profiles[profile].poll_budget);
+}
+
+serial_driver_error_t
+serial_driver_set_flow_control(serial_descriptor_t descriptor,
+                               const serial_flow_control_config_t *config)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    xr17c358_channel_register_map_t *registers = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+    uint32_t high_water = 0U;
+    uint32_t low_water = 0U;
+    uint8_t xon_char = 0U;
+    uint8_t xoff_char = 0U;
+    uint8_t efr = 0U;
+
+    if (config == NULL ||
+        (config->mode != SERIAL_FLOW_CONTROL_NONE &&
+         config->mode != SERIAL_FLOW_CONTROL_HW_RTS_CTS &&
+         config->mode != SERIAL_FLOW_CONTROL_HW_XON_XOFF &&
+         config->mode != SERIAL_FLOW_CONTROL_SW_RTS_CTS &&
+         config->mode != SERIAL_FLOW_CONTROL_SW_XON_XOFF))
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    xon_char = (config->xon_char != 0U) ? config->xon_char : UART_XON_CHAR;
+    xoff_char =
+        (config->xoff_char != 0U) ? config->xoff_char : UART_XOFF_CHAR;
+
+    /* Only the software modes read the watermarks; hardware modes ignore
+     * them rather than reject the configuration. */
+    if (config->mode == SERIAL_FLOW_CONTROL_SW_RTS_CTS ||
+        config->mode == SERIAL_FLOW_CONTROL_SW_XON_XOFF)
+    {
+        high_water = config->rts_high_water;
+        if (high_water == 0U)
+        {
+            high_water =
+                (uint32_t)((entry->uart_device->rx_queue->capacity * 3U) / 4U);
+        }
+        low_water = config->rts_low_water;
+        if (low_water == 0U)
+        {
+            low_water =
+                (uint32_t)(entry->uart_device->rx_queue->capacity / 4U);
+        }
+        if (low_water >= high_water ||
+            high_water > entry->uart_device->rx_queue->capacity)
+        {
+            return SERIAL_DRIVER_ERROR_INVALID_ARG;
+        }
+    }
+    if (config->mode == SERIAL_FLOW_CONTROL_SW_XON_XOFF &&
+        xon_char == xoff_char)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    registers = entry->uart_device->registers;
+    efr = (uint8_t)(registers->uart.efr &
+                    ~(XR17V358_EFR_AUTO_CTS_BIT | XR17V358_EFR_AUTO_RTS_BIT |
+                      XR17V358_EFR_SW_FLOW_MASK));
+    registers->uart.efr = (uint8_t)(efr | XR17V358_EFR_ENHANCED_BIT);
+    if (config->mode == SERIAL_FLOW_CONTROL_HW_RTS_CTS)
+    {
+        efr |= XR17V358_EFR_AUTO_CTS_BIT | XR17V358_EFR_AUTO_RTS_BIT;
+    }
+    else if (config->mode == SERIAL_FLOW_CONTROL_HW_XON_XOFF)
+    {
+        registers->uart.flow_control_3.xon1 = xon_char;
+        registers->uart.flow_control_1.xoff1 = xoff_char;
+        efr |= XR17V358_EFR_SW_FLOW_XON1_XOFF1;
+    }
+    registers->uart.efr = efr;
+    registers->uart.mcr |= UART_MCR_RTS_BIT;
+
+    entry->flow_control = config->mode;
+    entry->rts_high_water = high_water;
+    entry->rts_low_water = low_water;
+    entry->xon_char = xon_char;
+    entry->xoff_char = xoff_char;
+    entry->rx_throttled = false;
+    entry->tx_xoff_held = false;
+    entry->flow_char_pending = false;
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t
+serial_driver_read_rx_errors(serial_descriptor_t descriptor,
+                             serial_rx_error_t *out_errors, size_t capacity,
+                             size_t *out_count, uint64_t *out_dropped)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    serial_rx_error_log_t *log = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+    size_t count = 0U;
+
+    if (out_count == NULL || out_dropped == NULL ||
+        (capacity > 0U && out_errors == NULL))
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    *out_count = 0U;
+    *out_dropped = 0U;
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    log = &serial_rx_error_logs[(size_t)entry->port_index];
+    while (count < capacity && log->count > 0U)
+    {
+        out_errors[count] = log->entries[log->first];
+        log->first = (log->first + 1U) % SERIAL_RX_ERROR_LOG_DEPTH;
+        log->count -= 1U;
+        count += 1U;
+    }
+
+    *out_count = count;
+    *out_dropped = log->dropped;
+    log->dropped = 0U;
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t serial_driver_notify_rx(serial_descriptor_t descriptor)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    serial_driver_mark_pending(&serial_driver_rx_pending, entry);
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t serial_driver_poll_all(serial_poll_result_t *out_results,
+                                             size_t result_capacity,
+                                             size_t *out_result_count)
+{
+    uint32_t pending = 0U;
+    uint32_t tx_left = 0U;
+    uint32_t rx_left = 0U;
+    size_t count = 0U;
+
+    if (out_result_count == NULL ||
+        (result_capacity > 0U && out_results == NULL))
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    *out_result_count = 0U;
+
+    if (!serial_driver_common_initialized)
+    {
+        return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+    }
+
+    tx_left = atomic_exchange_explicit(&serial_driver_tx_pending, 0U,
+                                       memory_order_acquire);
+    rx_left = atomic_exchange_explicit(&serial_driver_rx_pending, 0U,
+                                       memory_order_acquire);
+    pending = tx_left | rx_left;
+
+    while (pending != 0U && count < result_capacity)
+    {
+        const size_t index = serial_driver_lowest_bit(pending);
+        const uint32_t bit = (uint32_t)1U << index;
+        serial_descriptor_entry_t *entry = &serial_descriptor_map[index];
+        serial_poll_result_t *result = &out_results[count];
+
+        pending &= ~bit;
+        tx_left &= ~bit;
+        rx_left &= ~bit;
+        if (!entry->initialized || entry->mode != UART_PORT_MODE_SERIAL)
+        {
+            continue;
+        }
+
+        result->descriptor = (serial_descriptor_t)(index + 1U);
+        result->tx_bytes = 0U;
+        result->rx_bytes = 0U;
+        result->status = serial_driver_service_entry(
+            entry, entry->poll_tx_budget, entry->poll_rx_budget,
+            &result->tx_bytes, &result->rx_bytes);
+        count += 1U;
+
+        if (serial_queue_size(entry->uart_device->tx_queue) != 0U)
+        {
+            tx_left |= bit;
+        }
+        if (serial_driver_rx_left(entry, result->rx_bytes))
+        {
+            rx_left |= bit;
+        }
+    }
+
+    /* Ports past the result capacity or with work left stay pending. */
+    if (tx_left != 0U)
+    {
+        (void)atomic_fetch_or_explicit(&serial_driver_tx_pending, tx_left,
+                                       memory_order_relaxed);
+    }
+    if (rx_left != 0U)
+    {
+        (void)atomic_fetch_or_explicit(&serial_driver_rx_pending, rx_left,
+                                       memory_order_relaxed);
+    }
+
+    *out_result_count = count;
+    return SERIAL_DRIVER_OK;
+}
+
+/* Open serial-mode entry bound to UART channel @p port, or NULL. */
+static serial_descriptor_entry_t *serial_driver_find_serial_port(size_t port)
+{
+    size_t index = 0U;
+
+    for (index = 0U; index < UART_DEVICE_COUNT; ++index)
+    {
+        serial_descriptor_entry_t *entry = &serial_descriptor_map[index];
+
+        if (entry->initialized && entry->port_index == (uint32_t)port)
+        {
+            return (entry->mode == UART_PORT_MODE_SERIAL) ? entry : NULL;
+        }
+    }
+
+    return NULL;
+}
+
+/* INT0 channel bits of @p card that map to a device slot. */
+static uint32_t serial_driver_card_channel_mask(size_t card)
+{
+    const size_t ports = UART_DEVICE_COUNT - card * XR17V358_UART_CHANNEL_COUNT;
+
+    if (ports >= XR17V358_UART_CHANNEL_COUNT)
+    {
+        return 0xFFU;
+    }
+    return ((uint32_t)1U << ports) - 1U;
+}
+
+serial_driver_error_t serial_driver_handle_interrupt(
+    size_t card, const xr17v358_device_config_registers_t *device_config,
+    uint32_t *out_channel_mask)
+{
+    const size_t first_port = card * XR17V358_UART_CHANNEL_COUNT;
+    uint32_t channels = 0U;
+    uint32_t sources = 0U;
+
+    if (card >= SERIAL_DRIVER_CARD_COUNT || device_config == NULL ||
+        out_channel_mask == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    *out_channel_mask = 0U;
+
+    if (!serial_driver_common_initialized)
+    {
+        return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+    }
+
+    channels = (uint32_t)device_config->generic.int0 &
+               serial_driver_card_channel_mask(card);
+    if (channels == 0U)
+    {
+        return SERIAL_DRIVER_OK;
+    }
+    sources = (uint32_t)device_config->generic.int1 |
+              ((uint32_t)device_config->generic.int2 << 8U) |
+              ((uint32_t)device_config->generic.int3 << 16U);
+    *out_channel_mask = channels;
+
+    while (channels != 0U)
+    {
+        const size_t channel = serial_driver_lowest_bit(channels);
+        const size_t port = first_port + channel;
+        const uint32_t source =
+            (sources >> (channel * XR17V358_INT_SOURCE_BITS)) &
+            XR17V358_INT_SOURCE_MASK;
+        serial_descriptor_entry_t *entry = serial_driver_find_serial_port(port);
+
+        channels &= channels - 1U;
+        if (entry == NULL)
+        {
+            continue;
+        }
+
+        switch (source)
+        {
+        case XR17V358_INT_SOURCE_RX_LINE_STATUS:
+        {
+            const uint8_t lsr = entry->uart_device->registers->uart.lsr;
+            serial_rx_error_log_t *log = &serial_rx_error_logs[port];
+
+            /* The status window already logs per byte on that path. */
+            if ((lsr & UART_LSR_RX_ERROR_MASK) != 0U &&
+                entry->data_path != SERIAL_DATA_PATH_MMIO_BURST_WITH_STATUS)
+            {
+                serial_driver_rx_error_log_push(log, log->rx_offset, lsr);
+            }
+            serial_driver_mark_pending(&serial_driver_rx_pending, entry);
+            break;
+        }
+        case XR17V358_INT_SOURCE_RX_TIMEOUT:
+            serial_driver_mark_pending(&serial_driver_rx_pending, entry);
+            break;
+        case XR17V358_INT_SOURCE_TX_EMPTY:
+            serial_driver_mark_pending(&serial_driver_tx_pending, entry);
+            break;
+        case XR17V358_INT_SOURCE_MODEM_STATUS:
+            (void)entry->uart_device->registers->uart.msr_or_rs485dly.msr;
+            break;
+        default:
+            break;
+        }
+    }
+
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t serial_driver_service_event(
+    size_t card, const xr17v358_device_config_registers_t *device_config,
+    serial_poll_result_t *out_results, size_t result_capacity,
+    size_t *out_result_count)
+{
+    uint32_t channels = 0U;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    if (out_result_count == NULL ||
+        (result_capacity > 0U && out_results == NULL))
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    *out_result_count = 0U;
+
+    status = serial_driver_handle_interrupt(card, device_config, &channels);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    return serial_driver_poll_all(out_results, result_capacity,
+                                  out_result_count);
+}
+
+static serial_driver_error_t
+serial_driver_set_mcr_bit(serial_descriptor_t descriptor, uart_port_mode_t mode,
+                          uint8_t bit_mask, bool enable)
+{
+    serial_descriptor_entry_t *entry = NULL;
+    volatile uint8_t *mcr = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    status = serial_driver_get_mode_entry(descriptor, mode, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    mcr = &entry->uart_device->registers->uart.mcr;
+    if (enable)
+    {
+        *mcr |= bit_mask;
+    }
+    else
+    {
+        *mcr &= (uint8_t)(~bit_mask);
+    }
+
+    return SERIAL_DRIVER_OK;
+}
+
+serial_driver_error_t
+serial_driver_enable_loopback(serial_descriptor_t descriptor)
+{
+    return serial_driver_set_mcr_bit(descriptor, UART_PORT_MODE_SERIAL,
+                                     UART_MCR_LOOPBACK_BIT, true);
+}
+
+serial_driver_error_t
+serial_driver_disable_loopback(serial_descriptor_t descriptor)
+{
+    return serial_driver_set_mcr_bit(descriptor, UART_PORT_MODE_SERIAL,
+                                     UART_MCR_LOOPBACK_BIT, false);
+}
+
+serial_driver_error_t
+serial_driver_enable_discrete(serial_descriptor_t descriptor)
+{
+    return serial_driver_set_mcr_bit(descriptor, UART_PORT_MODE_DISCRETE,
+                                     UART_MCR_DISCRETE_LINE_BIT, true);
+}
+
+serial_driver_error_t
+serial_driver_disable_discrete(serial_descriptor_t descriptor)
+{
+    return serial_driver_set_mcr_bit(descriptor, UART_PORT_MODE_DISCRETE,
+                                     UART_MCR_DISCRETE_LINE_BIT, false);
+}
+
+serial_driver_error_t
+serial_driver_open_event_fd(serial_descriptor_t descriptor,
+                            const serial_event_config_t *config, int *out_fd)
+{
+#if SERIAL_DRIVER_EVENTFD
+    serial_descriptor_entry_t *entry = NULL;
+    serial_driver_event_slot_t *slot = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    if (config == NULL || out_fd == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    slot = &serial_driver_event_slots[entry - serial_descriptor_map];
+    slot->rx_threshold =
+        (config->rx_threshold == 0U) ? 1U : config->rx_threshold;
+    slot->tx_low_water = config->tx_low_water;
+    if (!atomic_load_explicit(&slot->armed, memory_order_acquire))
+    {
+        slot->fd = eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (slot->fd < 0)
+        {
+            return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+        }
+        atomic_store_explicit(&slot->signalled, false, memory_order_relaxed);
+        atomic_store_explicit(&slot->armed, true, memory_order_release);
+    }
+
+    *out_fd = slot->fd;
+    return SERIAL_DRIVER_OK;
+#else
+    (void)descriptor;
+    (void)config;
+    (void)out_fd;
+    return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+#endif
+}
+
+serial_driver_error_t serial_driver_ack_event_fd(serial_descriptor_t descriptor,
+                                                 uint32_t *out_events)
+{
+#if SERIAL_DRIVER_EVENTFD
+    serial_descriptor_entry_t *entry = NULL;
+    serial_driver_event_slot_t *slot = NULL;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+    uint64_t count = 0U;
+
+    if (out_events == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    *out_events = 0U;
+
+    status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    slot = &serial_driver_event_slots[entry - serial_descriptor_map];
+    if (!atomic_load_explicit(&slot->armed, memory_order_acquire))
+    {
+        return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+    }
+
+    /* Re-arm before draining and sampling: a poll after this point either
+     * signals again or is already reflected in the levels. */
+    atomic_store_explicit(&slot->signalled, false, memory_order_seq_cst);
+    (void)read(slot->fd, &count, sizeof(count));
+    *out_events = serial_driver_event_levels(entry, slot);
+    return SERIAL_DRIVER_OK;
+#else
+    if (out_events != NULL)
+    {
+        *out_events = 0U;
+    }
+    (void)descriptor;
+    return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+#endif
+}
+
+serial_driver_error_t
+serial_driver_close_event_fd(serial_descriptor_t descriptor)
+{
+#if SERIAL_DRIVER_EVENTFD
+    serial_descriptor_entry_t *entry = NULL;
+    serial_driver_event_slot_t *slot = NULL;
+    serial_driver_error_t status =
+        serial_driver_get_mode_entry(descriptor, UART_PORT_MODE_SERIAL, &entry);
+
+    if (status != SERIAL_DRIVER_OK)
+    {
+        return status;
+    }
+
+    slot = &serial_driver_event_slots[entry - serial_descriptor_map];
+    if (!atomic_exchange_explicit(&slot->armed, false, memory_order_acq_rel))
+    {
+        return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+    }
+
+    (void)close(slot->fd);
+    slot->fd = -1;
+    return SERIAL_DRIVER_OK;
+#else
+    (void)descriptor;
+    return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+#endif
+}
+
+#if SERIAL_DRIVER_BLOCKING
+/*
+ * Driver-owned service threads: the single poller thread or the workers of
+ * a pool. A port is only serviced by the thread holding its claim flag, so
+ * ports move between workers without locks and keep their byte order.
+ */
+typedef struct SerialDriverWorker
+{
+    SERIAL_QUEUE_ALIGNAS(SERIAL_QUEUE_CACHE_LINE_BYTES)
+    pthread_t thread;
+    /* Ports this worker services on every pass. */
+    uint32_t home_ports;
+    SERIAL_QUEUE_ATOMIC(uint64_t) passes;
+    SERIAL_QUEUE_ATOMIC(uint64_t) busy_passes;
+    SERIAL_QUEUE_ATOMIC(uint64_t) pauses;
+    SERIAL_QUEUE_ATOMIC(uint64_t) yields;
+    SERIAL_QUEUE_ATOMIC(uint64_t) sleeps;
+    SERIAL_QUEUE_ATOMIC(uint64_t) steals;
+    SERIAL_QUEUE_ATOMIC(uint64_t) errors;
+    SERIAL_QUEUE_ATOMIC(int) last_error;
+} serial_driver_worker_t;
+
+typedef struct SerialDriverPortClaim
+{
+    SERIAL_QUEUE_ALIGNAS(SERIAL_QUEUE_CACHE_LINE_BYTES)
+    SERIAL_QUEUE_ATOMIC(bool) held;
+} serial_driver_port_claim_t;
+
+typedef struct SerialDriverEngine
+{
+    serial_poller_config_t backoff;
+    size_t worker_count;
+    /* Descriptor slots open in serial mode when the threads started. */
+    uint32_t ports;
+    bool steal;
+    bool pool;
+    SERIAL_QUEUE_ATOMIC(bool) running;
+    /* Ports dropped after a service returned an error. */
+    SERIAL_QUEUE_ATOMIC(uint32_t) failed;
+    serial_driver_worker_t workers[SERIAL_POOL_MAX_WORKERS];
+} serial_driver_engine_t;
+
+static serial_driver_engine_t serial_driver_engine;
+static serial_driver_port_claim_t serial_driver_port_claims[UART_DEVICE_COUNT];
+
+static void serial_driver_count(SERIAL_QUEUE_ATOMIC(uint64_t) * counter)
+{
+    (void)atomic_fetch_add_explicit(counter, 1U, memory_order_relaxed);
+}
+
+static void serial_driver_worker_backoff(serial_driver_worker_t *worker,
+                                         uint64_t idle_passes)
+{
+    const serial_poller_config_t *config = &serial_driver_engine.backoff;
+    uint64_t stage_end = config->spin_passes;
+
+    if (idle_passes <= stage_end)
+    {
+        return;
+    }
+    stage_end += config->pause_passes;
+    if (idle_passes <= stage_end)
+    {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+        __asm__ __volatile__("yield");
+#endif
+        serial_driver_count(&worker->pauses);
+        return;
+    }
+    stage_end += config->yield_passes;
+    if (idle_passes <= stage_end || config->sleep_us == 0U)
+    {
+        (void)sched_yield();
+        serial_driver_count(&worker->yields);
+        return;
+    }
+
+    {
+        const struct timespec delay = {
+            (time_t)(config->sleep_us / 1000000U),
+            (long)(config->sleep_us % 1000000U) * 1000L};
+
+        (void)nanosleep(&delay, NULL);
+        serial_driver_count(&worker->sleeps);
+    }
+}
+
+/* Service one port unless another worker holds it. Work left behind goes
+ * back into the pending masks, which is where idle workers steal from. A
+ * port whose service fails is recorded and dropped, not re-marked, so the
+ * workers do not spin on it. */
+static size_t serial_driver_worker_service(serial_driver_worker_t *worker,
+                                           size_t index)
+{
+    serial_driver_port_claim_t *claim = &serial_driver_port_claims[index];
+    serial_descriptor_entry_t *entry = &serial_descriptor_map[index];
+    const uint32_t bit = (uint32_t)1U << index;
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+    serial_driver_error_t status = SERIAL_DRIVER_OK;
+
+    if (atomic_exchange_explicit(&claim->held, true, memory_order_acquire))
+    {
+        return 0U;
+    }
+
+    (void)atomic_fetch_and_explicit(&serial_driver_tx_pending, ~bit,
+                                    memory_order_relaxed);
+    (void)atomic_fetch_and_explicit(&serial_driver_rx_pending, ~bit,
+                                    memory_order_relaxed);
+    status = serial_driver_service_entry(entry, entry->poll_tx_budget,
+                                         entry->poll_rx_budget, &tx_bytes,
+                                         &rx_bytes);
+    if (status != SERIAL_DRIVER_OK)
+    {
+        (void)atomic_fetch_or_explicit(&serial_driver_engine.failed, bit,
+                                       memory_order_relaxed);
+        atomic_store_explicit(&worker->last_error, (int)status,
+                              memory_order_relaxed);
+        serial_driver_count(&worker->errors);
+    }
+    else
+    {
+        if (serial_queue_size(entry->uart_device->tx_queue) != 0U)
+        {
+            serial_driver_mark_pending(&serial_driver_tx_pending, entry);
+        }
+        if (serial_driver_rx_left(entry, rx_bytes))
+        {
+            serial_driver_mark_pending(&serial_driver_rx_pending, entry);
+        }
+    }
+
+    atomic_store_explicit(&claim->held, false, memory_order_release);
+    return tx_bytes + rx_bytes;
+}
+
+static void *serial_driver_worker_main(void *arg)
+{
+    serial_driver_worker_t *worker = (serial_driver_worker_t *)arg;
+    uint64_t idle_passes = 0U;
+
+    while (atomic_load_explicit(&serial_driver_engine.running,
+                                memory_order_acquire))
+    {
+        const uint32_t failed = atomic_load_explicit(
+            &serial_driver_engine.failed, memory_order_relaxed);
+        uint32_t ports = worker->home_ports & ~failed;
+        size_t moved = 0U;
+
+        while (ports != 0U)
+        {
+            moved += serial_driver_worker_service(
+                worker, serial_driver_lowest_bit(ports));
+            ports &= ports - 1U;
+        }
+
+        if (moved == 0U && serial_driver_engine.steal)
+        {
+            ports = (atomic_load_explicit(&serial_driver_tx_pending,
+                                          memory_order_relaxed) |
+                     atomic_load_explicit(&serial_driver_rx_pending,
+                                          memory_order_relaxed)) &
+                    serial_driver_engine.ports & ~worker->home_ports & ~failed;
+            while (ports != 0U)
+            {
+                const size_t stolen = serial_driver_worker_service(
+                    worker, serial_driver_lowest_bit(ports));
+
+                ports &= ports - 1U;
+                if (stolen > 0U)
+                {
+                    moved += stolen;
+                    serial_driver_count(&worker->steals);
+                }
+            }
+        }
+
+        serial_driver_count(&worker->passes);
+        if (moved > 0U)
+        {
+            idle_passes = 0U;
+            serial_driver_count(&worker->busy_passes);
+            continue;
+        }
+        idle_passes += 1U;
+        serial_driver_worker_backoff(worker, idle_passes);
+    }
+
+    return NULL;
+}
+
+static void serial_driver_engine_join(size_t worker_count)
+{
+    size_t index = 0U;
+
+    for (index = 0U; index < worker_count; ++index)
+    {
+        (void)pthread_join(serial_driver_engine.workers[index].thread, NULL);
+    }
+}
+
+static serial_driver_error_t
+serial_driver_engine_start(const serial_poller_config_t *backoff,
+                           size_t worker_count, const int *worker_cpus,
+                           bool steal, bool pool)
+{
+    uint32_t ports = 0U;
+    size_t open_count = 0U;
+    size_t index = 0U;
+
+    if (!serial_driver_common_initialized)
+    {
+        return SERIAL_DRIVER_ERROR_NOT_INITIALIZED;
+    }
+    if (atomic_load_explicit(&serial_driver_engine.running,
+                             memory_order_acquire))
+    {
+        return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+    }
+
+    for (index = 0U; index < worker_count; ++index)
+    {
+        serial_driver_worker_t *worker = &serial_driver_engine.workers[index];
+
+        worker->home_ports = 0U;
+        atomic_store_explicit(&worker->passes, 0U, memory_order_relaxed);
+        atomic_store_explicit(&worker->busy_passes, 0U, memory_order_relaxed);
+        atomic_store_explicit(&worker->pauses, 0U, memory_order_relaxed);
+        atomic_store_explicit(&worker->yields, 0U, memory_order_relaxed);
+        atomic_store_explicit(&worker->sleeps, 0U, memory_order_relaxed);
+        atomic_store_explicit(&worker->steals, 0U, memory_order_relaxed);
+        atomic_store_explicit(&worker->errors, 0U, memory_order_relaxed);
+        atomic_store_explicit(&worker->last_error, (int)SERIAL_DRIVER_OK,
+                              memory_order_relaxed);
+    }
+    for (index = 0U; index < UART_DEVICE_COUNT; ++index)
+    {
+        if (serial_descriptor_map[index].initialized &&
+            serial_descriptor_map[index].mode == UART_PORT_MODE_SERIAL)
+        {
+            ports |= (uint32_t)1U << index;
+            serial_driver_engine.workers[open_count % worker_count]
+                .home_ports |= (uint32_t)1U << index;
+            open_count += 1U;
+        }
+    }
+
+    serial_driver_engine.backoff = *backoff;
+    serial_driver_engine.worker_count = worker_count;
+    serial_driver_engine.ports = ports;
+    serial_driver_engine.steal = steal;
+    serial_driver_engine.pool = pool;
+    atomic_store_explicit(&serial_driver_engine.failed, 0U,
+                          memory_order_relaxed);
+    atomic_store_explicit(&serial_driver_engine.running, true,
+                          memory_order_release);
+
+    for (index = 0U; index < worker_count; ++index)
+    {
+        serial_driver_worker_t *worker = &serial_driver_engine.workers[index];
+        pthread_attr_t attr;
+        int error = 0;
+
+        (void)pthread_attr_init(&attr);
+        if (worker_cpus != NULL && worker_cpus[index] >= 0)
+        {
+#if defined(__linux__)
+            cpu_set_t cpus;
+
+            CPU_ZERO(&cpus);
+            CPU_SET((size_t)worker_cpus[index], &cpus);
+            error = pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+#else
+            error = EINVAL;
+#endif
+        }
+        if (error == 0)
+        {
+            error = pthread_create(&worker->thread, &attr,
+                                   serial_driver_worker_main, worker);
+        }
+        (void)pthread_attr_destroy(&attr);
+        if (error != 0)
+        {
+            atomic_store_explicit(&serial_driver_engine.running, false,
+                                  memory_order_release);
+            serial_driver_engine_join(index);
+            return SERIAL_DRIVER_ERROR_INVALID_ARG;
+        }
+    }
+
+    return SERIAL_DRIVER_OK;
+}
+
+static serial_driver_error_t serial_driver_engine_stop(bool pool)
+{
+    if (!atomic_load_explicit(&serial_driver_engine.running,
+                              memory_order_acquire) ||
+        serial_driver_engine.pool != pool)
+    {
+        return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+    }
+
+    atomic_store_explicit(&serial_driver_engine.running, false,
+                          memory_order_release);
+    serial_driver_engine_join(serial_driver_engine.worker_count);
+    return SERIAL_DRIVER_OK;
+}
+
+static void serial_driver_worker_stats(size_t worker,
+                                       serial_poller_stats_t *out_stats)
+{
+    serial_driver_worker_t *source = &serial_driver_engine.workers[worker];
+
+    out_stats->passes =
+        atomic_load_explicit(&source->passes, memory_order_relaxed);
+    out_stats->busy_passes =
+        atomic_load_explicit(&source->busy_passes, memory_order_relaxed);
+    out_stats->pauses =
+        atomic_load_explicit(&source->pauses, memory_order_relaxed);
+    out_stats->yields =
+        atomic_load_explicit(&source->yields, memory_order_relaxed);
+    out_stats->sleeps =
+        atomic_load_explicit(&source->sleeps, memory_order_relaxed);
+    out_stats->steals =
+        atomic_load_explicit(&source->steals, memory_order_relaxed);
+    out_stats->errors =
+        atomic_load_explicit(&source->errors, memory_order_relaxed);
+    out_stats->last_error = (serial_driver_error_t)atomic_load_explicit(
+        &source->last_error, memory_order_relaxed);
+}
+#endif
+
+serial_driver_error_t
+serial_driver_start_poller(const serial_poller_config_t *config)
+{
+#if SERIAL_DRIVER_BLOCKING
+    static const serial_poller_config_t defaults = {-1, 1024U, 4096U, 256U,
+                                                    100U};
+
+    if (config == NULL)
+    {
+        config = &defaults;
+    }
+    return serial_driver_engine_start(config, 1U, &config->cpu, false, false);
+#else
+    (void)config;
+    return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+#endif
+}
+
+serial_driver_error_t serial_driver_stop_poller(void)
+{
+#if SERIAL_DRIVER_BLOCKING
+    return serial_driver_engine_stop(false);
+#else
+    return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+#endif
+}
+
+serial_driver_error_t
+serial_driver_get_poller_stats(serial_poller_stats_t *out_stats)
+{
+    if (out_stats == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    memset(out_stats, 0, sizeof(*out_stats));
+#if SERIAL_DRIVER_BLOCKING
+    /* Pool counters are per worker; see serial_driver_get_pool_stats(). */
+    if (serial_driver_engine.pool)
+    {
+        return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+    }
+    serial_driver_worker_stats(0U, out_stats);
+    return SERIAL_DRIVER_OK;
+#else
+    return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+#endif
+}
+
+serial_driver_error_t
+serial_driver_start_pool(const serial_pool_config_t *config)
+{
+#if SERIAL_DRIVER_BLOCKING
+    if (config == NULL || config->worker_count == 0U ||
+        config->worker_count > SERIAL_POOL_MAX_WORKERS)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    return serial_driver_engine_start(&config->backoff, config->worker_count,
+                                      config->worker_cpus,
+                                      !config->static_partition, true);
+#else
+    (void)config;
+    return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+#endif
+}
+
+serial_driver_error_t serial_driver_stop_pool(void)
+{
+#if SERIAL_DRIVER_BLOCKING
+    return serial_driver_engine_stop(true);
+#else
+    return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+#endif
+}
+
+serial_driver_error_t
+serial_driver_get_pool_stats(size_t worker, serial_poller_stats_t *out_stats)
+{
+    if (out_stats == NULL)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+
+    memset(out_stats, 0, sizeof(*out_stats));
+#if SERIAL_DRIVER_BLOCKING
+    if (!serial_driver_engine.pool ||
+        worker >= serial_driver_engine.worker_count)
+    {
+        return SERIAL_DRIVER_ERROR_INVALID_ARG;
+    }
+    serial_driver_worker_stats(worker, out_stats);
+    return SERIAL_DRIVER_OK;
+#else
+    (void)worker;
+    return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+#endif
+}
+
+serial_driver_error_t serial_driver_reset(void)
+{
+    size_t index = 0U;
+
+#if SERIAL_DRIVER_BLOCKING
+    if (atomic_load_explicit(&serial_driver_engine.running,
+                             memory_order_acquire))
+    {
+        return SERIAL_DRIVER_ERROR_NOT_CONFIGURED;
+    }
+#endif
+
+    for (index = 0U; index < UART_DEVICE_COUNT; ++index)
+    {
+#if SERIAL_DRIVER_EVENTFD
+        serial_driver_event_slot_t *slot = &serial_driver_event_slots[index];
+
+        if (atomic_exchange_explicit(&slot->armed, false,
+                                     memory_order_acq_rel))
+        {
+            (void)close(slot->fd);
+            slot->fd = -1;
+        }
+        atomic_store_explicit(&slot->signalled, false, memory_order_relaxed);
+#endif
+#if SERIAL_DRIVER_BLOCKING
+        atomic_store_explicit(&serial_driver_port_claims[index].held, false,
+                              memory_order_relaxed);
+#endif
+        uart_devices[index].registers = NULL;
+    }
+    atomic_store_explicit(&serial_driver_tx_pending, 0U,
+                          memory_order_relaxed);
+    atomic_store_explicit(&serial_driver_rx_pending, 0U,
+                          memory_order_relaxed);
+
+    return serial_driver_common_init();
 }
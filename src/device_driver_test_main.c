@@ -1,4 +1,3 @@
-#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
@@ -11,17 +10,18 @@
 
 static xr17c358_channel_register_map_t g_mock_registers[UART_DEVICE_COUNT];
 
-static uart_error_t map_mock_uart_registers(size_t port_index,
-                                            uart_device_t *uart_device)
+static uart_error_t map_mock_uart_registers(size_t port_index, uart_device_t *uart_device,
+                                            uart_device_info_t *device_info)
 {
-    if (uart_device == NULL || port_index >= UART_DEVICE_COUNT)
+    if (uart_device == NULL || device_info == NULL ||
+        port_index >= UART_DEVICE_COUNT)
     {
         return UART_ERROR_INVALID_ARG;
     }
 
     uart_device->registers = &g_mock_registers[port_index];
-    uart_device->device_name = "mock-uart";
-    uart_device->uart_base_address = (uintptr_t)&g_mock_registers[port_index];
+    device_info->device_name = "mock-uart";
+    device_info->uart_base_address = (uintptr_t)&g_mock_registers[port_index];
 
     return UART_ERROR_NONE;
 }
@@ -31,12 +31,8 @@ static int configure_mock_uart_registers(void)
     for (size_t i = 0; i < UART_DEVICE_COUNT; ++i)
     {
         memset(&g_mock_registers[i], 0, sizeof(g_mock_registers[i]));
-        uart_fifo_map.write_fifos[i].head = 0;
-        uart_fifo_map.write_fifos[i].tail = 0;
-        uart_fifo_map.write_fifos[i].count = 0;
-        uart_fifo_map.read_fifos[i].head = 0;
-        uart_fifo_map.read_fifos[i].tail = 0;
-        uart_fifo_map.read_fifos[i].count = 0;
+        serial_driver_byte_fifo_reset(&uart_fifo_map.write_fifos[i]);
+        serial_driver_byte_fifo_reset(&uart_fifo_map.read_fifos[i]);
     }
 
     return serial_driver_hw_set_mapper(map_mock_uart_registers) ==
@@ -45,33 +41,10 @@ static int configure_mock_uart_registers(void)
                : 1;
 }
 
-static bool fifo_is_empty(const uart_byte_fifo_t *fifo)
-{
-    return fifo->count == 0U;
-}
-
-static bool fifo_is_full(const uart_byte_fifo_t *fifo)
-{
-    return fifo->count == UART_DEVICE_FIFO_SIZE_BYTES;
-}
-
-static uint8_t fifo_pop(uart_byte_fifo_t *fifo)
-{
-    uint8_t value = fifo->data[fifo->tail];
-    fifo->tail = (fifo->tail + 1U) % UART_DEVICE_FIFO_SIZE_BYTES;
-    fifo->count -= 1U;
-    return value;
-}
-
-static void fifo_push(uart_byte_fifo_t *fifo, uint8_t value)
-{
-    fifo->data[fifo->head] = value;
-    fifo->head = (fifo->head + 1U) % UART_DEVICE_FIFO_SIZE_BYTES;
-    fifo->count += 1U;
-}
-
 static int run_port6_serial_roundtrip(void)
 {
+    uart_byte_fifo_t *write_fifo = &uart_fifo_map.write_fifos[TEST_PORT_SERIAL];
+    uart_byte_fifo_t *read_fifo = &uart_fifo_map.read_fifos[TEST_PORT_SERIAL];
     serial_descriptor_t serial_descriptor = SERIAL_DESCRIPTOR_INVALID;
     uint8_t tx_data[4] = {0x11U, 0x22U, 0x33U, 0x44U};
     uint8_t rx_data[sizeof(tx_data)] = {0U};
@@ -118,11 +91,13 @@ static int run_port6_serial_roundtrip(void)
         return 1;
     }
 
-    while (!fifo_is_empty(&uart_fifo_map.write_fifos[TEST_PORT_SERIAL]) &&
-           !fifo_is_full(&uart_fifo_map.read_fifos[TEST_PORT_SERIAL]))
+    while (!serial_driver_byte_fifo_is_empty(write_fifo) &&
+           read_fifo->count < UART_DEVICE_FIFO_SIZE_BYTES)
     {
-        fifo_push(&uart_fifo_map.read_fifos[TEST_PORT_SERIAL],
-                  fifo_pop(&uart_fifo_map.write_fifos[TEST_PORT_SERIAL]));
+        uint8_t value = 0U;
+
+        serial_driver_byte_fifo_read(write_fifo, &value, 1U);
+        serial_driver_byte_fifo_write(read_fifo, &value, 1U);
     }
 
     if (serial_driver_poll(serial_descriptor, 0U, sizeof(tx_data),
@@ -2,39 +2,48 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
+
+/* Longest default name: "uart", the digits of an unsigned int and NUL. */
+#define DEFAULT_DEVICE_NAME_BYTES 16U
 
 static xr17c358_channel_register_map_t
     default_register_blocks[UART_DEVICE_COUNT] = {0};
-static const char *const default_device_names[UART_DEVICE_COUNT] = {
-    "uart0", "uart1", "uart2", "uart3", "uart4", "uart5", "uart6", "uart7"};
+/* "uart<N>" per slot, formatted the first time the slot is mapped. */
+static char default_device_names[UART_DEVICE_COUNT][DEFAULT_DEVICE_NAME_BYTES];
 
-static uart_error_t serial_driver_default_hw_map(size_t port_index,
-                                                 uart_device_t *uart_device)
+static uart_error_t
+serial_driver_default_hw_map(size_t port_index, uart_device_t *uart_device,
+                             uart_device_info_t *device_info)
 {
 
-    if (uart_device == NULL || port_index >= UART_DEVICE_COUNT)
+    if (uart_device == NULL || device_info == NULL ||
+        port_index >= UART_DEVICE_COUNT)
     {
         return UART_ERROR_INVALID_ARG;
     }
 
     if (uart_device->registers == NULL)
     {
-        if (uart_device->uart_base_address != (uintptr_t)0U)
+        if (device_info->uart_base_address != (uintptr_t)0U)
         {
             uart_device->registers = (xr17c358_channel_register_map_t *)
-                                         uart_device->uart_base_address;
+                                         device_info->uart_base_address;
         }
         else
         {
             uart_device->registers = &default_register_blocks[port_index];
-            uart_device->uart_base_address =
+            device_info->uart_base_address =
                 (uintptr_t)&default_register_blocks[port_index];
         }
     }
 
-    if (uart_device->device_name == NULL)
+    if (device_info->device_name == NULL)
     {
-        uart_device->device_name = default_device_names[port_index];
+        (void)snprintf(default_device_names[port_index],
+                       sizeof(default_device_names[port_index]), "uart%u",
+                       (unsigned int)port_index);
+        device_info->device_name = default_device_names[port_index];
     }
 
     return UART_ERROR_NONE;
@@ -44,9 +53,10 @@ static serial_driver_hw_map_fn serial_driver_hw_mapper =
     serial_driver_default_hw_map;
 
 uart_error_t serial_driver_hw_map_uart(size_t port_index,
-                                       uart_device_t *uart_device)
+                                       uart_device_t *uart_device,
+                                       uart_device_info_t *device_info)
 {
-    return serial_driver_hw_mapper(port_index, uart_device);
+    return serial_driver_hw_mapper(port_index, uart_device, device_info);
 }
 
 uart_error_t serial_driver_hw_set_mapper(serial_driver_hw_map_fn mapper)
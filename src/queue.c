@@ -1,65 +1,478 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "device_driver/queue.h"
 
-static size_t queue_next_index(const serial_queue_t *queue, size_t current) {
-    (void)queue;
-    return (current + 1U) % SERIAL_QUEUE_FIXED_SIZE_WORDS;
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sched.h>
+#endif
+
+/** Spins on a busy commit slot before yielding the CPU. */
+#define SERIAL_QUEUE_COMMIT_SPINS 64U
+
+_Static_assert(sizeof(SERIAL_QUEUE_ATOMIC(uint64_t)) == sizeof(uint64_t),
+               "queue indices must keep the C++-visible layout");
+
+static size_t queue_entry_size(const serial_queue_t *queue) {
+    return (queue->mode == SERIAL_QUEUE_MODE_BYTE) ? 1U : sizeof(uint32_t);
+}
+
+/*
+ * Indices are free-running 64-bit counters on every target; only storage
+ * offsets are folded into [0, capacity). An index therefore does not wrap
+ * in practice, which keeps the modulo fold of non-power-of-two capacities
+ * continuous and means a multi-producer CAS on a stale reserve index
+ * cannot succeed after the ring has gone round. Power-of-two capacities
+ * (index_mask != 0) fold with a mask instead of a division.
+ */
+static size_t queue_offset(const serial_queue_t *queue, uint64_t index) {
+    if (queue->index_mask != 0U) {
+        return (size_t)(index & queue->index_mask);
+    }
+    return (size_t)(index % queue->capacity);
+}
+
+static void queue_commit_backoff(size_t spins) {
+    if (spins < SERIAL_QUEUE_COMMIT_SPINS) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+        __asm__ __volatile__("yield");
+#endif
+        return;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    (void)sched_yield();
+#endif
 }
 
-uart_error_t serial_queue_init(serial_queue_t *queue) {
-    if (queue == NULL) {
+static uart_error_t queue_init_mode(serial_queue_t *queue,
+                                    serial_queue_mode_t mode, uint8_t *storage,
+                                    size_t capacity) {
+    if (queue == NULL || storage == NULL) {
         return UART_ERROR_INVALID_ARG;
     }
 
-    queue->head = 0U;
-    queue->tail = 0U;
-    queue->count = 0U;
+    queue->mode = mode;
+    queue->storage = storage;
+    queue->capacity = capacity;
+    queue->index_mask =
+        ((capacity & (capacity - 1U)) == 0U) ? capacity - 1U : 0U;
+    atomic_store_explicit(&queue->head, 0U, memory_order_relaxed);
+    atomic_store_explicit(&queue->tail, 0U, memory_order_relaxed);
+    atomic_store_explicit(&queue->reserve, 0U, memory_order_relaxed);
     queue->initialized = true;
     return UART_ERROR_NONE;
 }
 
+/*
+ * Producer side: copy up to @p count entries in with at most two memcpy
+ * calls, then publish them with a release store of head. Callers have
+ * already validated arguments and mode.
+ */
+static size_t queue_write_entries(serial_queue_t *queue, const void *src,
+                                  size_t count) {
+    const size_t entry_size = queue_entry_size(queue);
+    const uint8_t *source = (const uint8_t *)src;
+    const uint64_t head =
+        atomic_load_explicit(&queue->head, memory_order_relaxed);
+    const uint64_t tail =
+        atomic_load_explicit(&queue->tail, memory_order_acquire);
+    const size_t offset = queue_offset(queue, head);
+    size_t accepted = queue->capacity - (size_t)(head - tail);
+    size_t first = 0U;
+
+    if (accepted > count) {
+        accepted = count;
+    }
+
+    first = queue->capacity - offset;
+    if (first > accepted) {
+        first = accepted;
+    }
+    if (first != 0U) {
+        memcpy(&queue->storage[offset * entry_size], source,
+               first * entry_size);
+    }
+    if (accepted - first != 0U) {
+        memcpy(&queue->storage[0], &source[first * entry_size],
+               (accepted - first) * entry_size);
+    }
+
+    atomic_store_explicit(&queue->head, head + accepted, memory_order_release);
+    return accepted;
+}
+
+/*
+ * Consumer side: copy up to @p count entries out, then hand the slots back
+ * to the producer with a release store of tail.
+ */
+static size_t queue_read_entries(serial_queue_t *queue, void *dst,
+                                 size_t count) {
+    const size_t entry_size = queue_entry_size(queue);
+    uint8_t *destination = (uint8_t *)dst;
+    const uint64_t tail =
+        atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    const uint64_t head =
+        atomic_load_explicit(&queue->head, memory_order_acquire);
+    const size_t offset = queue_offset(queue, tail);
+    size_t available = (size_t)(head - tail);
+    size_t first = 0U;
+
+    if (available > count) {
+        available = count;
+    }
+
+    first = queue->capacity - offset;
+    if (first > available) {
+        first = available;
+    }
+    if (first != 0U) {
+        memcpy(destination, &queue->storage[offset * entry_size],
+               first * entry_size);
+    }
+    if (available - first != 0U) {
+        memcpy(&destination[first * entry_size], &queue->storage[0],
+               (available - first) * entry_size);
+    }
+
+    atomic_store_explicit(&queue->tail, tail + available, memory_order_release);
+    return available;
+}
+
+static uart_error_t queue_push_entries(serial_queue_t *queue,
+                                       serial_queue_mode_t mode,
+                                       const void *src, size_t count,
+                                       size_t *out_pushed) {
+    if (out_pushed == NULL || (count > 0U && src == NULL)) {
+        return UART_ERROR_INVALID_ARG;
+    }
+    *out_pushed = 0U;
+
+    if (queue == NULL || !queue->initialized) {
+        return UART_ERROR_NOT_INITIALIZED;
+    }
+
+    if (queue->mode != mode) {
+        return UART_ERROR_NOT_CONFIGURED;
+    }
+
+    *out_pushed = queue_write_entries(queue, src, count);
+    return (*out_pushed == 0U && count > 0U) ? UART_ERROR_FIFO_QUEUE_FULL
+                                             : UART_ERROR_NONE;
+}
+
+static uart_error_t queue_pop_entries(serial_queue_t *queue,
+                                      serial_queue_mode_t mode, void *dst,
+                                      size_t count, size_t *out_popped) {
+    if (queue == NULL || out_popped == NULL || (count > 0U && dst == NULL)) {
+        return UART_ERROR_INVALID_ARG;
+    }
+    *out_popped = 0U;
+
+    if (!queue->initialized) {
+        return UART_ERROR_NOT_INITIALIZED;
+    }
+
+    if (queue->mode != mode) {
+        return UART_ERROR_NOT_CONFIGURED;
+    }
+
+    *out_popped = queue_read_entries(queue, dst, count);
+    return (*out_popped == 0U && count > 0U) ? UART_ERROR_FIFO_QUEUE_EMPTY
+                                             : UART_ERROR_NONE;
+}
+
+uart_error_t serial_queue_init(serial_queue_t *queue,
+                               serial_queue_buffer_t *buffer) {
+    return queue_init_mode(queue, SERIAL_QUEUE_MODE_WORD,
+                           (buffer != NULL) ? buffer->bytes : NULL,
+                           SERIAL_QUEUE_FIXED_SIZE_WORDS);
+}
+
+uart_error_t serial_queue_init_bytes(serial_queue_t *queue,
+                                     serial_queue_buffer_t *buffer) {
+    return queue_init_mode(queue, SERIAL_QUEUE_MODE_BYTE,
+                           (buffer != NULL) ? buffer->bytes : NULL,
+                           SERIAL_QUEUE_FIXED_SIZE_BYTES);
+}
+
+uart_error_t serial_queue_init_bytes_ex(serial_queue_t *queue,
+                                        uint8_t *storage, size_t capacity) {
+    if (capacity == 0U || capacity > SERIAL_QUEUE_MAX_CAPACITY_BYTES) {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    return queue_init_mode(queue, SERIAL_QUEUE_MODE_BYTE, storage, capacity);
+}
+
 uart_error_t serial_queue_push(serial_queue_t *queue, uint32_t value) {
-    size_t next_head = 0U;
+    size_t pushed = 0U;
+
+    return queue_push_entries(queue, SERIAL_QUEUE_MODE_WORD, &value, 1U,
+                              &pushed);
+}
+
+uart_error_t serial_queue_pop(serial_queue_t *queue, uint32_t *out_value) {
+    size_t popped = 0U;
+
+    if (out_value == NULL) {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    return queue_pop_entries(queue, SERIAL_QUEUE_MODE_WORD, out_value, 1U,
+                             &popped);
+}
+
+uart_error_t serial_queue_push_n(serial_queue_t *queue, const uint32_t *values,
+                                 size_t count, size_t *out_pushed) {
+    return queue_push_entries(queue, SERIAL_QUEUE_MODE_WORD, values, count,
+                              out_pushed);
+}
+
+uart_error_t serial_queue_pop_n(serial_queue_t *queue, uint32_t *out_values,
+                                size_t count, size_t *out_popped) {
+    return queue_pop_entries(queue, SERIAL_QUEUE_MODE_WORD, out_values, count,
+                             out_popped);
+}
+
+uart_error_t serial_queue_push_bytes(serial_queue_t *queue,
+                                     const uint8_t *data, size_t count,
+                                     size_t *out_pushed) {
+    return queue_push_entries(queue, SERIAL_QUEUE_MODE_BYTE, data, count,
+                              out_pushed);
+}
+
+uart_error_t serial_queue_pop_bytes(serial_queue_t *queue, uint8_t *out_data,
+                                    size_t count, size_t *out_popped) {
+    return queue_pop_entries(queue, SERIAL_QUEUE_MODE_BYTE, out_data, count,
+                             out_popped);
+}
 
+static uart_error_t queue_check_bytes(const serial_queue_t *queue) {
     if (queue == NULL || !queue->initialized) {
         return UART_ERROR_NOT_INITIALIZED;
     }
 
-    if (queue->count == SERIAL_QUEUE_FIXED_SIZE_WORDS) {
+    return (queue->mode == SERIAL_QUEUE_MODE_BYTE) ? UART_ERROR_NONE
+                                                   : UART_ERROR_NOT_CONFIGURED;
+}
+
+/* Split @p count bytes starting at @p index into storage-order spans. */
+static void queue_split_spans(serial_queue_t *queue, uint64_t index,
+                              size_t count, serial_span_t *out_first,
+                              serial_span_t *out_second) {
+    const size_t offset = queue_offset(queue, index);
+    size_t first = queue->capacity - offset;
+
+    if (first > count) {
+        first = count;
+    }
+    out_first->data = (first > 0U) ? &queue->storage[offset] : NULL;
+    out_first->length = first;
+    out_second->data = (count > first) ? &queue->storage[0] : NULL;
+    out_second->length = count - first;
+}
+
+uart_error_t serial_queue_reserve_bytes(serial_queue_t *queue,
+                                        size_t min_count,
+                                        serial_span_t *out_first,
+                                        serial_span_t *out_second) {
+    uart_error_t error = UART_ERROR_NONE;
+    uint64_t head = 0U;
+    size_t free_count = 0U;
+
+    if (out_first == NULL || out_second == NULL) {
+        return UART_ERROR_INVALID_ARG;
+    }
+    out_first->data = NULL;
+    out_first->length = 0U;
+    out_second->data = NULL;
+    out_second->length = 0U;
+
+    error = queue_check_bytes(queue);
+    if (error != UART_ERROR_NONE) {
+        return error;
+    }
+
+    head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    free_count = queue->capacity -
+                 (size_t)(head - atomic_load_explicit(&queue->tail,
+                                                      memory_order_acquire));
+    if (free_count < min_count || free_count == 0U) {
         return UART_ERROR_FIFO_QUEUE_FULL;
     }
 
-    next_head = queue_next_index(queue, queue->head);
-    queue->buffer[queue->head] = value;
-    queue->head = next_head;
-    queue->count += 1U;
+    queue_split_spans(queue, head, free_count, out_first, out_second);
     return UART_ERROR_NONE;
 }
 
-uart_error_t serial_queue_pop(serial_queue_t *queue, uint32_t *out_value) {
-    if (queue == NULL || out_value == NULL) {
+uart_error_t serial_queue_commit_bytes(serial_queue_t *queue, size_t count) {
+    uart_error_t error = queue_check_bytes(queue);
+    uint64_t head = 0U;
+
+    if (error != UART_ERROR_NONE) {
+        return error;
+    }
+
+    head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    if (count > queue->capacity -
+                    (size_t)(head - atomic_load_explicit(
+                                        &queue->tail, memory_order_acquire))) {
         return UART_ERROR_INVALID_ARG;
     }
 
-    if (!queue->initialized) {
-        return UART_ERROR_NOT_INITIALIZED;
+    atomic_store_explicit(&queue->head, head + count, memory_order_release);
+    return UART_ERROR_NONE;
+}
+
+uart_error_t serial_queue_peek_bytes(serial_queue_t *queue,
+                                     serial_const_span_t *out_first,
+                                     serial_const_span_t *out_second) {
+    uart_error_t error = UART_ERROR_NONE;
+    serial_span_t first = {NULL, 0U};
+    serial_span_t second = {NULL, 0U};
+    uint64_t tail = 0U;
+    size_t used = 0U;
+
+    if (out_first == NULL || out_second == NULL) {
+        return UART_ERROR_INVALID_ARG;
+    }
+    out_first->data = NULL;
+    out_first->length = 0U;
+    out_second->data = NULL;
+    out_second->length = 0U;
+
+    error = queue_check_bytes(queue);
+    if (error != UART_ERROR_NONE) {
+        return error;
     }
 
-    if (queue->count == 0U) {
+    tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    used = (size_t)(atomic_load_explicit(&queue->head, memory_order_acquire) -
+                    tail);
+    if (used == 0U) {
         return UART_ERROR_FIFO_QUEUE_EMPTY;
     }
 
-    *out_value = queue->buffer[queue->tail];
-    queue->tail = queue_next_index(queue, queue->tail);
-    queue->count -= 1U;
+    queue_split_spans(queue, tail, used, &first, &second);
+    out_first->data = first.data;
+    out_first->length = first.length;
+    out_second->data = second.data;
+    out_second->length = second.length;
+    return UART_ERROR_NONE;
+}
+
+uart_error_t serial_queue_consume_bytes(serial_queue_t *queue, size_t count) {
+    uart_error_t error = queue_check_bytes(queue);
+    uint64_t tail = 0U;
+
+    if (error != UART_ERROR_NONE) {
+        return error;
+    }
+
+    tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    if (count > (size_t)(atomic_load_explicit(&queue->head,
+                                              memory_order_acquire) -
+                         tail)) {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    atomic_store_explicit(&queue->tail, tail + count, memory_order_release);
+    return UART_ERROR_NONE;
+}
+
+uart_error_t serial_queue_push_bytes_mp(serial_queue_t *queue,
+                                        const uint8_t *data, size_t count) {
+    uart_error_t error = UART_ERROR_NONE;
+    uint64_t start = 0U;
+    uint64_t end = 0U;
+    size_t offset = 0U;
+    size_t first = 0U;
+    size_t spins = 0U;
+
+    if (count > 0U && data == NULL) {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    error = queue_check_bytes(queue);
+    if (error != UART_ERROR_NONE) {
+        return error;
+    }
+
+    if (count > queue->capacity) {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    if (count == 0U) {
+        return UART_ERROR_NONE;
+    }
+
+    /* Claim [start, end) against the consumer's tail. */
+    start = atomic_load_explicit(&queue->reserve, memory_order_relaxed);
+    do {
+        const uint64_t tail =
+            atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+        if (queue->capacity - (size_t)(start - tail) < count) {
+            return UART_ERROR_FIFO_QUEUE_FULL;
+        }
+        end = start + count;
+    } while (!atomic_compare_exchange_weak_explicit(
+        &queue->reserve, &start, end, memory_order_relaxed,
+        memory_order_relaxed));
+
+    offset = queue_offset(queue, start);
+    first = queue->capacity - offset;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(&queue->storage[offset], data, first);
+    memcpy(&queue->storage[0], &data[first], count - first);
+
+    /* Commit in reservation order so head never exposes a gap. */
+    while (atomic_load_explicit(&queue->head, memory_order_acquire) != start) {
+        queue_commit_backoff(spins++);
+    }
+    atomic_store_explicit(&queue->head, end, memory_order_release);
+    return UART_ERROR_NONE;
+}
+
+uart_error_t serial_queue_sync_producers(serial_queue_t *queue) {
+    if (queue == NULL || !queue->initialized) {
+        return UART_ERROR_NOT_INITIALIZED;
+    }
+
+    atomic_store_explicit(
+        &queue->reserve,
+        atomic_load_explicit(&queue->head, memory_order_acquire),
+        memory_order_release);
     return UART_ERROR_NONE;
 }
 
 size_t serial_queue_size(const serial_queue_t *queue) {
+    uint64_t tail = 0U;
+    uint64_t head = 0U;
+
+    if (queue == NULL || !queue->initialized) {
+        return 0U;
+    }
+
+    /* Const-qualified atomics are not loadable in C11; the cast is benign. */
+    tail = atomic_load_explicit(&((serial_queue_t *)queue)->tail,
+                                memory_order_acquire);
+    head = atomic_load_explicit(&((serial_queue_t *)queue)->head,
+                                memory_order_acquire);
+    return (size_t)(head - tail);
+}
+
+size_t serial_queue_space(const serial_queue_t *queue) {
     if (queue == NULL || !queue->initialized) {
         return 0U;
     }
 
-    return queue->count;
+    return queue->capacity - serial_queue_size(queue);
 }
 
 bool serial_queue_is_empty(const serial_queue_t *queue) {
@@ -71,5 +484,5 @@ bool serial_queue_is_full(const serial_queue_t *queue) {
         return false;
     }
 
-    return queue->count == SERIAL_QUEUE_FIXED_SIZE_WORDS;
+    return serial_queue_size(queue) == queue->capacity;
 }
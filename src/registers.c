@@ -1,4 +1,79 @@
 #include "device_driver/registers.h"
 
+#include <string.h>
+
+_Static_assert(UART_QUEUE_ARENA_RING_BYTES ==
+                   ((SERIAL_QUEUE_FIXED_SIZE_BYTES +
+                     SERIAL_QUEUE_CACHE_LINE_BYTES - 1U) /
+                    SERIAL_QUEUE_CACHE_LINE_BYTES) *
+                       SERIAL_QUEUE_CACHE_LINE_BYTES,
+               "arena ring size must match the built-in ring size");
+
+SERIAL_QUEUE_ALIGNAS(SERIAL_QUEUE_CACHE_LINE_BYTES)
 uart_device_t uart_devices[UART_DEVICE_COUNT] = {0};
+uart_device_info_t uart_device_info[UART_DEVICE_COUNT] = {0};
+uart_queue_pair_t uart_queue_pool[UART_SERIAL_QUEUE_POOL_SIZE] = {0};
+#if UART_QUEUE_ARENA_BYTES > 0
+SERIAL_QUEUE_ALIGNAS(SERIAL_QUEUE_CACHE_LINE_BYTES)
+uint8_t uart_queue_arena[UART_QUEUE_ARENA_BYTES];
+#endif
 uart_fifo_map_t uart_fifo_map = {0};
+
+void serial_driver_byte_fifo_reset(uart_byte_fifo_t *fifo)
+{
+    if (fifo == NULL)
+    {
+        return;
+    }
+
+    fifo->head = 0U;
+    fifo->tail = 0U;
+    fifo->count = 0U;
+}
+
+bool serial_driver_byte_fifo_is_empty(const uart_byte_fifo_t *fifo)
+{
+    return fifo == NULL || fifo->count == 0U; /* LCOV_EXCL_BR_LINE */
+}
+
+void serial_driver_byte_fifo_write(uart_byte_fifo_t *fifo, const uint8_t *data,
+                                   size_t length)
+{
+    size_t first = UART_DEVICE_FIFO_SIZE_BYTES - fifo->head;
+
+    if (length == 0U)
+    {
+        return;
+    }
+
+    if (first > length)
+    {
+        first = length;
+    }
+    memcpy(&fifo->data[fifo->head], data, first);
+    memcpy(&fifo->data[0], &data[first], length - first);
+    fifo->head =
+        (uint16_t)((fifo->head + length) & UART_DEVICE_FIFO_INDEX_MASK);
+    fifo->count = (uint16_t)(fifo->count + length);
+}
+
+void serial_driver_byte_fifo_read(uart_byte_fifo_t *fifo, uint8_t *data,
+                                  size_t length)
+{
+    size_t first = UART_DEVICE_FIFO_SIZE_BYTES - fifo->tail;
+
+    if (length == 0U)
+    {
+        return;
+    }
+
+    if (first > length)
+    {
+        first = length;
+    }
+    memcpy(data, &fifo->data[fifo->tail], first);
+    memcpy(&data[first], &fifo->data[0], length - first);
+    fifo->tail =
+        (uint16_t)((fifo->tail + length) & UART_DEVICE_FIFO_INDEX_MASK);
+    fifo->count = (uint16_t)(fifo->count - length);
+}
@@ -0,0 +1,356 @@
+#include "device_driver/simulator.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "device_driver/device_driver.h"
+#include "device_driver/hw_abstraction.h"
+
+#define SERIAL_DRIVER_SIM_NS_PER_SECOND 1000000000ULL
+
+/*
+ * Longest stretch of virtual time handled in one step. Keeps the
+ * ns * clock products in serial_driver_sim_step well inside 64 bits.
+ */
+#define SERIAL_DRIVER_SIM_MAX_STEP_NS SERIAL_DRIVER_SIM_NS_PER_SECOND
+
+/*
+ * Line timing of one channel. Time is counted in rate units per
+ * nanosecond and a character costs cost units, so any clock, divisor and
+ * 1.5 stop bits stay in integers (the frame is counted in half bits).
+ */
+typedef struct SerialDriverSimLine
+{
+    uint64_t rate;
+    uint64_t cost;
+} serial_driver_sim_line_t;
+
+typedef struct SerialDriverSimChannel
+{
+    /* Port at the other end of the cable, or SERIAL_DRIVER_SIM_NO_PEER. */
+    size_t peer;
+    /* Rate units accumulated towards the next character. */
+    uint64_t phase;
+    serial_driver_sim_stats_t stats;
+} serial_driver_sim_channel_t;
+
+static xr17c358_channel_register_map_t
+    serial_driver_sim_registers[UART_DEVICE_COUNT];
+static serial_driver_sim_channel_t
+    serial_driver_sim_channels[UART_DEVICE_COUNT];
+
+static uart_error_t serial_driver_sim_map(size_t port_index, uart_device_t *uart_device,
+                                          uart_device_info_t *device_info)
+{
+    if (uart_device == NULL || device_info == NULL ||
+        port_index >= UART_DEVICE_COUNT)
+    {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    uart_device->registers = &serial_driver_sim_registers[port_index];
+    device_info->uart_base_address =
+        (uintptr_t)&serial_driver_sim_registers[port_index];
+    device_info->device_name = "sim-uart";
+    return UART_ERROR_NONE;
+}
+
+/* Only ports opened while the simulator was installed are simulated. */
+static bool serial_driver_sim_owns(size_t port_index)
+{
+    return uart_devices[port_index].registers ==
+           &serial_driver_sim_registers[port_index];
+}
+
+static bool serial_driver_sim_in_loopback(size_t port_index)
+{
+    return (serial_driver_sim_registers[port_index].uart.mcr &
+            UART_MCR_LOOPBACK_BIT) != 0U;
+}
+
+static serial_driver_sim_line_t serial_driver_sim_line(size_t port_index)
+{
+    const xr17c358_channel_register_map_t *registers =
+        &serial_driver_sim_registers[port_index];
+    const uint8_t channel_bit =
+        (uint8_t)(1U << (port_index % XR17V358_UART_CHANNEL_COUNT));
+    serial_driver_sim_line_t line = {0U, 0U};
+    uint64_t divisor = 0U;
+    uint64_t sampling = 16U;
+    uint64_t data_bits = 0U;
+    uint64_t half_bits = 0U;
+    uint8_t lcr = 0U;
+
+    divisor = (uint64_t)registers->uart.data.dll |
+              ((uint64_t)registers->uart.interrupt_enable.dlm << 8U);
+    if (divisor == 0U)
+    {
+        /* 8N1: start, eight data bits and one stop bit. */
+        line.rate = 2U * (uint64_t)SERIAL_DRIVER_SIM_DEFAULT_BAUD;
+        line.cost = 20U * SERIAL_DRIVER_SIM_NS_PER_SECOND;
+        return line;
+    }
+
+    lcr = registers->uart.lcr;
+    data_bits = 5U + (uint64_t)(lcr & UART_LCR_WORD_LENGTH_MASK);
+    half_bits = 2U * (1U + data_bits);
+    if ((lcr & UART_LCR_PARITY_ENABLE_BIT) != 0U)
+    {
+        half_bits += 2U;
+    }
+    if ((lcr & UART_LCR_STOP_BITS_BIT) == 0U)
+    {
+        half_bits += 2U;
+    }
+    else
+    {
+        half_bits += (data_bits == 5U) ? 3U : 4U;
+    }
+
+    if ((registers->device_config.generic.mode_8x & channel_bit) != 0U)
+    {
+        sampling = 8U;
+    }
+    else if ((registers->device_config.generic.mode_4x & channel_bit) != 0U)
+    {
+        sampling = 4U;
+    }
+
+    line.rate = 2U * (uint64_t)SERIAL_DRIVER_UART_CLOCK_HZ;
+    line.cost =
+        half_bits * sampling * divisor * SERIAL_DRIVER_SIM_NS_PER_SECOND;
+    return line;
+}
+
+/*
+ * Drive CTS from the RTS at the other end: the channel's own RTS in
+ * loopback, otherwise the peer's unless the peer's outputs are looped back
+ * internally.
+ */
+static void serial_driver_sim_update_modem(size_t port_index)
+{
+    xr17c358_channel_register_map_t *registers =
+        &serial_driver_sim_registers[port_index];
+    const size_t peer = serial_driver_sim_channels[port_index].peer;
+    uint8_t rts = 0U;
+
+    if (serial_driver_sim_in_loopback(port_index))
+    {
+        rts = registers->uart.mcr;
+    }
+    else if (peer != SERIAL_DRIVER_SIM_NO_PEER &&
+             !serial_driver_sim_in_loopback(peer))
+    {
+        rts = serial_driver_sim_registers[peer].uart.mcr;
+    }
+
+    if ((rts & UART_MCR_RTS_BIT) != 0U)
+    {
+        registers->uart.msr_or_rs485dly.msr |= UART_MSR_CTS_BIT;
+    }
+    else
+    {
+        registers->uart.msr_or_rs485dly.msr &= (uint8_t)(~UART_MSR_CTS_BIT);
+    }
+}
+
+/*
+ * Put one byte on the wire. In loopback the transmitter feeds the
+ * channel's own receiver and nothing leaves the chip; a peer in loopback
+ * ignores its RX pin.
+ */
+static void serial_driver_sim_deliver(size_t port_index, uint8_t byte)
+{
+    size_t target = serial_driver_sim_channels[port_index].peer;
+    uart_byte_fifo_t *fifo = NULL;
+
+    if (serial_driver_sim_in_loopback(port_index))
+    {
+        target = port_index;
+    }
+    else if (target == SERIAL_DRIVER_SIM_NO_PEER ||
+             serial_driver_sim_in_loopback(target) ||
+             !serial_driver_sim_owns(target))
+    {
+        serial_driver_sim_channels[port_index].stats.dropped += 1U;
+        return;
+    }
+
+    fifo = &uart_fifo_map.read_fifos[target];
+    if (fifo->count == UART_DEVICE_FIFO_SIZE_BYTES)
+    {
+        serial_driver_sim_channels[target].stats.overruns += 1U;
+        serial_driver_sim_registers[target].uart.lsr |= UART_LSR_OVERRUN_BIT;
+        return;
+    }
+
+    serial_driver_byte_fifo_write(fifo, &byte, 1U);
+    serial_driver_sim_channels[target].stats.rx_bytes += 1U;
+}
+
+/* Shift out the characters whose frame time ends within elapsed_ns. */
+static void serial_driver_sim_step(size_t port_index, uint64_t elapsed_ns)
+{
+    serial_driver_sim_channel_t *channel =
+        &serial_driver_sim_channels[port_index];
+    const xr17c358_channel_register_map_t *registers =
+        &serial_driver_sim_registers[port_index];
+    uart_byte_fifo_t *fifo = &uart_fifo_map.write_fifos[port_index];
+    serial_driver_sim_line_t line = {0U, 0U};
+    uint64_t chars = 0U;
+
+    if (serial_driver_byte_fifo_is_empty(fifo) ||
+        ((registers->uart.efr & XR17V358_EFR_AUTO_CTS_BIT) != 0U &&
+         (registers->uart.msr_or_rs485dly.msr & UART_MSR_CTS_BIT) == 0U))
+    {
+        channel->phase = 0U;
+        return;
+    }
+
+    line = serial_driver_sim_line(port_index);
+    channel->phase += elapsed_ns * line.rate;
+    chars = channel->phase / line.cost;
+    if (chars > fifo->count)
+    {
+        chars = fifo->count;
+    }
+    channel->phase -= chars * line.cost;
+    channel->stats.tx_bytes += chars;
+
+    while (chars > 0U)
+    {
+        uint8_t byte = 0U;
+
+        serial_driver_byte_fifo_read(fifo, &byte, 1U);
+        serial_driver_sim_deliver(port_index, byte);
+        chars -= 1U;
+    }
+
+    /* An empty transmitter idles; the next byte starts a fresh frame. */
+    if (serial_driver_byte_fifo_is_empty(fifo))
+    {
+        channel->phase = 0U;
+    }
+}
+
+uart_error_t serial_driver_sim_install(void)
+{
+    size_t index = 0U;
+
+    memset(serial_driver_sim_registers, 0,
+           sizeof(serial_driver_sim_registers));
+    for (index = 0U; index < UART_DEVICE_COUNT; ++index)
+    {
+        memset(&serial_driver_sim_channels[index], 0,
+               sizeof(serial_driver_sim_channels[index]));
+        serial_driver_sim_channels[index].peer = SERIAL_DRIVER_SIM_NO_PEER;
+        serial_driver_byte_fifo_reset(&uart_fifo_map.write_fifos[index]);
+        serial_driver_byte_fifo_reset(&uart_fifo_map.read_fifos[index]);
+    }
+
+    return serial_driver_hw_set_mapper(serial_driver_sim_map);
+}
+
+void serial_driver_sim_uninstall(void) { serial_driver_hw_reset_mapper(); }
+
+uart_error_t serial_driver_sim_connect(size_t port_a, size_t port_b)
+{
+    if (port_a >= UART_DEVICE_COUNT || port_b >= UART_DEVICE_COUNT ||
+        port_a == port_b)
+    {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    (void)serial_driver_sim_disconnect(port_a);
+    (void)serial_driver_sim_disconnect(port_b);
+    serial_driver_sim_channels[port_a].peer = port_b;
+    serial_driver_sim_channels[port_b].peer = port_a;
+    return UART_ERROR_NONE;
+}
+
+uart_error_t serial_driver_sim_disconnect(size_t port_index)
+{
+    size_t peer = SERIAL_DRIVER_SIM_NO_PEER;
+
+    if (port_index >= UART_DEVICE_COUNT)
+    {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    peer = serial_driver_sim_channels[port_index].peer;
+    if (peer != SERIAL_DRIVER_SIM_NO_PEER)
+    {
+        serial_driver_sim_channels[peer].peer = SERIAL_DRIVER_SIM_NO_PEER;
+    }
+    serial_driver_sim_channels[port_index].peer = SERIAL_DRIVER_SIM_NO_PEER;
+    return UART_ERROR_NONE;
+}
+
+void serial_driver_sim_advance(uint64_t elapsed_ns)
+{
+    size_t index = 0U;
+
+    do
+    {
+        const uint64_t step = (elapsed_ns < SERIAL_DRIVER_SIM_MAX_STEP_NS)
+                                  ? elapsed_ns
+                                  : SERIAL_DRIVER_SIM_MAX_STEP_NS;
+
+        for (index = 0U; index < UART_DEVICE_COUNT; ++index)
+        {
+            if (serial_driver_sim_owns(index))
+            {
+                serial_driver_sim_update_modem(index);
+            }
+        }
+        for (index = 0U; index < UART_DEVICE_COUNT; ++index)
+        {
+            if (serial_driver_sim_owns(index))
+            {
+                serial_driver_sim_step(index, step);
+            }
+        }
+        elapsed_ns -= step;
+    } while (elapsed_ns > 0U);
+
+    for (index = 0U; index < UART_DEVICE_COUNT; ++index)
+    {
+        volatile uint8_t *lsr = &serial_driver_sim_registers[index].uart.lsr;
+
+        if (!serial_driver_byte_fifo_is_empty(&uart_fifo_map.read_fifos[index]))
+        {
+            *lsr |= UART_LSR_DATA_READY_BIT;
+        }
+        else
+        {
+            *lsr &= (uint8_t)(~UART_LSR_DATA_READY_BIT);
+        }
+    }
+}
+
+uint64_t serial_driver_sim_char_time_ns(size_t port_index)
+{
+    serial_driver_sim_line_t line = {0U, 0U};
+
+    if (port_index >= UART_DEVICE_COUNT)
+    {
+        return 0U;
+    }
+
+    line = serial_driver_sim_line(port_index);
+    return line.cost / line.rate;
+}
+
+uart_error_t serial_driver_sim_get_stats(size_t port_index,
+                                         serial_driver_sim_stats_t *out_stats)
+{
+    if (port_index >= UART_DEVICE_COUNT || out_stats == NULL)
+    {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    *out_stats = serial_driver_sim_channels[port_index].stats;
+    return UART_ERROR_NONE;
+}
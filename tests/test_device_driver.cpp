@@ -1,24 +1,39 @@
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <thread>
+#include <vector>
 
 extern "C"
 {
 #include "device_driver/device_driver.h"
 #include "device_driver/hw_abstraction.h"
+
+    /* Test-only hook defined in device_driver.c. */
+    serial_driver_error_t serial_driver_reset(void);
 }
 
 #include <gtest/gtest.h>
 
+#if SERIAL_DRIVER_EVENTFD
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace
 {
 
 std::array<xr17c358_channel_register_map_t, UART_DEVICE_COUNT>
     g_test_registers{};
 
-uart_error_t TestMapper(size_t port_index, uart_device_t *uart_device)
+uart_error_t TestMapper(size_t port_index, uart_device_t *uart_device,
+                        uart_device_info_t *device_info)
 {
-    if (uart_device == nullptr || port_index >= UART_DEVICE_COUNT)
+    if (uart_device == nullptr || device_info == nullptr ||
+        port_index >= UART_DEVICE_COUNT)
     {
         return UART_ERROR_INVALID_ARG;
     }
@@ -27,9 +42,9 @@ uart_error_t TestMapper(size_t port_index, uart_device_t *uart_device)
                 sizeof(g_test_registers[port_index]));
 
     uart_device->registers = &g_test_registers[port_index];
-    uart_device->uart_base_address =
+    device_info->uart_base_address =
         reinterpret_cast<uintptr_t>(&g_test_registers[port_index]);
-    uart_device->device_name = "test-uart";
+    device_info->device_name = "test-uart";
 
     return UART_ERROR_NONE;
 }
@@ -83,18 +98,26 @@ size_t MoveWriteToRead(size_t port_index)
 class SerialDriverApiTest : public ::testing::Test
 {
   protected:
+    /* Every test starts from closed ports, so the binary also passes when
+     * all tests share one process. */
     void SetUp() override
     {
         ASSERT_EQ(serial_driver_hw_set_mapper(TestMapper), UART_ERROR_NONE);
+        ASSERT_EQ(serial_driver_reset(), SERIAL_DRIVER_OK);
     }
 
-    void TearDown() override { serial_driver_hw_reset_mapper(); }
+    void TearDown() override
+    {
+        (void)serial_driver_stop_poller();
+        (void)serial_driver_stop_pool();
+        EXPECT_EQ(serial_driver_reset(), SERIAL_DRIVER_OK);
+        serial_driver_hw_reset_mapper();
+    }
 };
 
 TEST_F(SerialDriverApiTest, PortInitRejectsInvalidPortAndMode)
 {
-    EXPECT_EQ(serial_port_init(static_cast<serial_ports_t>(UART_DEVICE_COUNT),
-                               UART_PORT_MODE_SERIAL),
+    EXPECT_EQ(serial_port_init(SERIAL_PORT_COUNT, UART_PORT_MODE_SERIAL),
               SERIAL_DESCRIPTOR_INVALID);
 
     EXPECT_EQ(
@@ -119,6 +142,9 @@ TEST_F(SerialDriverApiTest, SerialRoundTripViaPollAndReadWrite)
     const serial_descriptor_t descriptor = serial_port_init(
         static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
     ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    EXPECT_STREQ(uart_device_info[kPort].device_name, "test-uart");
+    EXPECT_EQ(uart_device_info[kPort].uart_base_address,
+              reinterpret_cast<uintptr_t>(uart_devices[kPort].registers));
 
     ASSERT_EQ(serial_driver_enable_loopback(descriptor), SERIAL_DRIVER_OK);
     ASSERT_NE((uart_devices[kPort].registers->uart.mcr & UART_MCR_LOOPBACK_BIT),
@@ -276,3 +302,1680 @@ TEST_F(SerialDriverApiTest, InvalidDescriptorReturnsNotInitialized)
     EXPECT_EQ(serial_driver_enable_discrete(SERIAL_DESCRIPTOR_INVALID),
               SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
 }
+
+TEST_F(SerialDriverApiTest, BulkRoundTripPreservesOddLengthPayload)
+{
+    constexpr size_t kPort = SERIAL_PORT_5;
+    std::array<uint8_t, 203> payload{};
+    std::array<uint8_t, payload.size()> received{};
+    size_t bytes_written = 0U;
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+    size_t bytes_read = 0U;
+
+    for (size_t i = 0U; i < payload.size(); ++i)
+    {
+        payload[i] = static_cast<uint8_t>(i * 7U + 3U);
+    }
+
+    ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+    ResetFifo(&uart_fifo_map.read_fifos[kPort]);
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+
+    ASSERT_EQ(serial_driver_write(descriptor, payload.data(), payload.size(),
+                                  &bytes_written),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(bytes_written, payload.size());
+
+    ASSERT_EQ(serial_driver_poll(descriptor, payload.size(), 0U, &tx_bytes,
+                                 &rx_bytes),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(tx_bytes, payload.size());
+    ASSERT_EQ(MoveWriteToRead(kPort), payload.size());
+
+    ASSERT_EQ(serial_driver_poll(descriptor, 0U, payload.size(), &tx_bytes,
+                                 &rx_bytes),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(rx_bytes, payload.size());
+
+    /* Read in uneven slices to cross word boundaries on the output side. */
+    size_t offset = 0U;
+    while (offset < received.size())
+    {
+        const size_t slice = std::min<size_t>(5U, received.size() - offset);
+        ASSERT_EQ(serial_driver_read(descriptor, &received[offset], slice,
+                                     &bytes_read),
+                  SERIAL_DRIVER_OK);
+        ASSERT_EQ(bytes_read, slice);
+        offset += bytes_read;
+    }
+    EXPECT_EQ(received, payload);
+}
+
+TEST_F(SerialDriverApiTest, MultiProducerWriteModeIsAllOrNothing)
+{
+    constexpr size_t kPort = SERIAL_PORT_6;
+    std::array<uint8_t, SERIAL_QUEUE_FIXED_SIZE_BYTES> payload{};
+    size_t bytes_written = 0U;
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+
+    EXPECT_EQ(serial_driver_set_write_mode(
+                  descriptor, static_cast<serial_write_mode_t>(7)),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_set_write_mode(SERIAL_DESCRIPTOR_INVALID,
+                                           SERIAL_WRITE_MODE_MULTI_PRODUCER),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+
+    ASSERT_EQ(serial_driver_write(descriptor, payload.data(), 100U,
+                                  &bytes_written),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_set_write_mode(descriptor,
+                                           SERIAL_WRITE_MODE_MULTI_PRODUCER),
+              SERIAL_DRIVER_OK);
+
+    EXPECT_EQ(serial_driver_write(descriptor, payload.data(),
+                                  payload.size() - 99U, &bytes_written),
+              SERIAL_DRIVER_ERROR_TX_FULL);
+    EXPECT_EQ(bytes_written, 0U);
+    EXPECT_EQ(serial_driver_write(descriptor, payload.data(),
+                                  payload.size() + 1U, &bytes_written),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_write(descriptor, payload.data(),
+                                  payload.size() - 100U, &bytes_written),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(bytes_written, payload.size() - 100U);
+
+    ASSERT_EQ(serial_driver_set_write_mode(descriptor,
+                                           SERIAL_WRITE_MODE_SINGLE_PRODUCER),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_write(descriptor, payload.data(), 1U,
+                                  &bytes_written),
+              SERIAL_DRIVER_ERROR_TX_FULL);
+}
+
+TEST_F(SerialDriverApiTest, ReserveCommitEncodesInPlaceAcrossWrap)
+{
+    constexpr size_t kPort = SERIAL_PORT_7;
+    serial_span_t first = {};
+    serial_span_t second = {};
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+    size_t bytes_read = 0U;
+
+    ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+    ResetFifo(&uart_fifo_map.read_fifos[kPort]);
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+
+    EXPECT_EQ(serial_driver_write_reserve(descriptor, 1U, nullptr, &second),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_write_reserve(SERIAL_DESCRIPTOR_INVALID, 1U,
+                                          &first, &second),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+    EXPECT_EQ(serial_driver_write_reserve(descriptor,
+                                          SERIAL_QUEUE_FIXED_SIZE_BYTES + 1U,
+                                          &first, &second),
+              SERIAL_DRIVER_ERROR_TX_FULL);
+    EXPECT_EQ(serial_driver_write_commit(descriptor,
+                                         SERIAL_QUEUE_FIXED_SIZE_BYTES + 1U),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+
+    /* Advance the ring so the next reservation straddles its end. */
+    ASSERT_EQ(serial_driver_write_reserve(descriptor, 1100U, &first, &second),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(first.length + second.length, SERIAL_QUEUE_FIXED_SIZE_BYTES);
+    ASSERT_EQ(serial_driver_write_commit(descriptor, 1100U), SERIAL_DRIVER_OK);
+    size_t drained = 0U;
+    while (drained < 1100U)
+    {
+        ASSERT_EQ(serial_driver_poll(descriptor, UART_DEVICE_FIFO_SIZE_BYTES,
+                                     0U, &tx_bytes, &rx_bytes),
+                  SERIAL_DRIVER_OK);
+        ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+        drained += tx_bytes;
+    }
+
+    ASSERT_EQ(serial_driver_write_reserve(descriptor, 150U, &first, &second),
+              SERIAL_DRIVER_OK);
+    ASSERT_GT(second.length, 0U);
+    ASSERT_EQ(first.length + second.length, SERIAL_QUEUE_FIXED_SIZE_BYTES);
+
+    /* Encode a 150-byte frame straight into the ring. */
+    std::array<uint8_t, 150> expected{};
+    for (size_t i = 0U; i < expected.size(); ++i)
+    {
+        expected[i] = static_cast<uint8_t>(i * 11U + 1U);
+        uint8_t *slot = (i < first.length) ? &first.data[i]
+                                           : &second.data[i - first.length];
+        *slot = expected[i];
+    }
+    ASSERT_EQ(serial_driver_write_commit(descriptor, expected.size()),
+              SERIAL_DRIVER_OK);
+
+    ASSERT_EQ(serial_driver_poll(descriptor, expected.size(), 0U, &tx_bytes,
+                                 &rx_bytes),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(tx_bytes, expected.size());
+    ASSERT_EQ(MoveWriteToRead(kPort), expected.size());
+    ASSERT_EQ(serial_driver_poll(descriptor, 0U, expected.size(), &tx_bytes,
+                                 &rx_bytes),
+              SERIAL_DRIVER_OK);
+
+    std::array<uint8_t, expected.size()> received{};
+    ASSERT_EQ(serial_driver_read(descriptor, received.data(), received.size(),
+                                 &bytes_read),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(bytes_read, received.size());
+    EXPECT_EQ(received, expected);
+
+    ASSERT_EQ(serial_driver_set_write_mode(descriptor,
+                                           SERIAL_WRITE_MODE_MULTI_PRODUCER),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_write_reserve(descriptor, 1U, &first, &second),
+              SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+    EXPECT_EQ(first.length + second.length, 0U);
+    EXPECT_EQ(serial_driver_write_commit(descriptor, 0U),
+              SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+}
+
+TEST_F(SerialDriverApiTest, PeekConsumeParsesInPlaceAcrossWrap)
+{
+    constexpr size_t kPort = SERIAL_PORT_5;
+    serial_const_span_t first = {};
+    serial_const_span_t second = {};
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+    uint8_t next = 0U;
+
+    ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+    ResetFifo(&uart_fifo_map.read_fifos[kPort]);
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+
+    EXPECT_EQ(serial_driver_read_peek(descriptor, &first, nullptr),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_read_peek(SERIAL_DESCRIPTOR_INVALID, &first,
+                                      &second),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+    EXPECT_EQ(serial_driver_read_consume(SERIAL_DESCRIPTOR_INVALID, 0U),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+    EXPECT_EQ(serial_driver_read_peek(descriptor, &first, &second),
+              SERIAL_DRIVER_ERROR_RX_EMPTY);
+    EXPECT_EQ(serial_driver_read_consume(descriptor, 1U),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+
+    /* Receive and release 1100 bytes so later data wraps in the RX ring. */
+    auto receive = [&](size_t count) {
+        while (count > 0U)
+        {
+            const size_t chunk =
+                std::min<size_t>(count, UART_DEVICE_FIFO_SIZE_BYTES);
+            for (size_t i = 0U; i < chunk; ++i)
+            {
+                FifoPush(&uart_fifo_map.read_fifos[kPort], next++);
+            }
+            ASSERT_EQ(serial_driver_poll(descriptor, 0U, chunk, &tx_bytes,
+                                         &rx_bytes),
+                      SERIAL_DRIVER_OK);
+            ASSERT_EQ(rx_bytes, chunk);
+            count -= chunk;
+        }
+    };
+    receive(1100U);
+    ASSERT_EQ(serial_driver_read_peek(descriptor, &first, &second),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(first.length + second.length, 1100U);
+    EXPECT_EQ(first.data[0], 0U);
+    ASSERT_EQ(serial_driver_read_consume(descriptor, 1100U), SERIAL_DRIVER_OK);
+
+    const uint8_t expected_start = next;
+    receive(300U);
+    ASSERT_EQ(serial_driver_read_peek(descriptor, &first, &second),
+              SERIAL_DRIVER_OK);
+    ASSERT_GT(second.length, 0U);
+    ASSERT_EQ(first.length + second.length, 300U);
+
+    /* Scan in place; the sequence must continue across the span boundary. */
+    uint8_t expected = expected_start;
+    for (size_t i = 0U; i < 300U; ++i)
+    {
+        const uint8_t value = (i < first.length)
+                                  ? first.data[i]
+                                  : second.data[i - first.length];
+        ASSERT_EQ(value, expected++);
+    }
+
+    ASSERT_EQ(serial_driver_read_consume(descriptor, 10U), SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_read_peek(descriptor, &first, &second),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(first.data[0], static_cast<uint8_t>(expected_start + 10U));
+    EXPECT_EQ(serial_driver_read_consume(descriptor, 291U),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    ASSERT_EQ(serial_driver_read_consume(descriptor, 290U), SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_read_peek(descriptor, &first, &second),
+              SERIAL_DRIVER_ERROR_RX_EMPTY);
+}
+
+TEST_F(SerialDriverApiTest, PortInitExSizesRingsFromConfig)
+{
+    constexpr size_t kPort = SERIAL_PORT_2;
+    static uint8_t tx_storage[8192];
+    std::array<uint8_t, 5000> payload{};
+    serial_port_config_t config = {};
+    size_t bytes_written = 0U;
+
+    EXPECT_EQ(serial_port_init_ex(static_cast<serial_ports_t>(kPort), nullptr),
+              SERIAL_DESCRIPTOR_INVALID);
+
+    config.mode = UART_PORT_MODE_SERIAL;
+    config.rx_capacity = SERIAL_QUEUE_FIXED_SIZE_BYTES + 1U;
+    EXPECT_EQ(serial_port_init_ex(static_cast<serial_ports_t>(kPort), &config),
+              SERIAL_DESCRIPTOR_INVALID);
+
+    config.tx_storage = tx_storage;
+    config.tx_capacity = sizeof(tx_storage);
+    config.rx_capacity = 256U;
+    const serial_descriptor_t descriptor =
+        serial_port_init_ex(static_cast<serial_ports_t>(kPort), &config);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    EXPECT_EQ(serial_port_init(static_cast<serial_ports_t>(kPort),
+                               UART_PORT_MODE_SERIAL),
+              descriptor);
+
+    EXPECT_EQ(uart_devices[kPort].tx_queue->storage, tx_storage);
+    EXPECT_EQ(serial_queue_space(uart_devices[kPort].rx_queue), 256U);
+
+    ASSERT_EQ(serial_driver_write(descriptor, payload.data(), payload.size(),
+                                  &bytes_written),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(bytes_written, payload.size());
+    EXPECT_EQ(serial_driver_write(descriptor, payload.data(), payload.size(),
+                                  &bytes_written),
+              SERIAL_DRIVER_ERROR_TX_FULL);
+    EXPECT_EQ(bytes_written, sizeof(tx_storage) - payload.size());
+}
+
+TEST_F(SerialDriverApiTest, FirmwareImageRoundTripsThroughBulkPath)
+{
+    constexpr size_t kPort = SERIAL_PORT_3;
+    static uint8_t tx_storage[16384];
+    static uint8_t rx_storage[16384];
+    std::vector<uint8_t> image(40000U + 3U);
+    std::vector<uint8_t> received(image.size());
+    serial_port_config_t config = {};
+    size_t sent = 0U;
+    size_t read_total = 0U;
+
+    for (size_t i = 0U; i < image.size(); ++i)
+    {
+        image[i] = static_cast<uint8_t>((i * 131U) ^ (i >> 8));
+    }
+
+    ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+    ResetFifo(&uart_fifo_map.read_fifos[kPort]);
+
+    config.mode = UART_PORT_MODE_SERIAL;
+    config.tx_storage = tx_storage;
+    config.tx_capacity = sizeof(tx_storage);
+    config.rx_storage = rx_storage;
+    config.rx_capacity = sizeof(rx_storage);
+    const serial_descriptor_t descriptor =
+        serial_port_init_ex(static_cast<serial_ports_t>(kPort), &config);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+
+    /*
+     * Odd write/read sizes keep every copy unaligned against the rings. RX is
+     * only serviced once TX is drained, so each write fits the two FIFOs.
+     */
+    while (read_total < image.size())
+    {
+        size_t bytes_written = 0U;
+        size_t bytes_read = 0U;
+        size_t tx_bytes = 0U;
+        size_t rx_bytes = 0U;
+
+        if (sent < image.size())
+        {
+            ASSERT_EQ(serial_driver_write(
+                          descriptor, &image[sent],
+                          std::min<size_t>(509U, image.size() - sent),
+                          &bytes_written),
+                      SERIAL_DRIVER_OK);
+            sent += bytes_written;
+        }
+
+        do
+        {
+            ASSERT_EQ(serial_driver_poll(descriptor,
+                                         UART_DEVICE_FIFO_SIZE_BYTES,
+                                         UART_DEVICE_FIFO_SIZE_BYTES, &tx_bytes,
+                                         &rx_bytes),
+                      SERIAL_DRIVER_OK);
+        } while (MoveWriteToRead(kPort) > 0U || tx_bytes > 0U ||
+                 rx_bytes > 0U);
+
+        while (serial_driver_read(
+                   descriptor, &received[read_total],
+                   std::min<size_t>(211U, received.size() - read_total),
+                   &bytes_read) == SERIAL_DRIVER_OK &&
+               bytes_read > 0U)
+        {
+            read_total += bytes_read;
+        }
+        ASSERT_EQ(read_total, sent);
+    }
+
+    EXPECT_EQ(received, image);
+}
+
+TEST_F(SerialDriverApiTest, PollAllServicesOnlyPendingPortsWithinBudgets)
+{
+    constexpr size_t kTxPort = SERIAL_PORT_0;
+    constexpr size_t kRxPort = SERIAL_PORT_4;
+    std::array<serial_poll_result_t, UART_DEVICE_COUNT> results{};
+    std::array<uint8_t, 100> payload{};
+    size_t count = 0U;
+    size_t bytes_written = 0U;
+
+    auto find = [&](serial_descriptor_t descriptor) -> serial_poll_result_t * {
+        for (size_t i = 0U; i < count; ++i)
+        {
+            if (results[i].descriptor == descriptor)
+            {
+                return &results[i];
+            }
+        }
+        return nullptr;
+    };
+
+    for (const size_t port : {kTxPort, kRxPort})
+    {
+        ResetFifo(&uart_fifo_map.write_fifos[port]);
+        ResetFifo(&uart_fifo_map.read_fifos[port]);
+    }
+    const serial_descriptor_t tx_descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kTxPort), UART_PORT_MODE_SERIAL);
+    const serial_descriptor_t rx_descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kRxPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(tx_descriptor, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_NE(rx_descriptor, SERIAL_DESCRIPTOR_INVALID);
+
+    EXPECT_EQ(serial_driver_poll_all(results.data(), results.size(), nullptr),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_poll_all(nullptr, 1U, &count),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_set_poll_budget(SERIAL_DESCRIPTOR_INVALID, 1U, 1U),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+    EXPECT_EQ(serial_driver_notify_rx(SERIAL_DESCRIPTOR_INVALID),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+
+    /* Idle ports are skipped. */
+    ASSERT_EQ(serial_driver_poll_all(results.data(), results.size(), &count),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(find(tx_descriptor), nullptr);
+    EXPECT_EQ(find(rx_descriptor), nullptr);
+
+    /* A write marks TX pending; the budget splits it over several calls. */
+    ASSERT_EQ(serial_driver_set_poll_budget(tx_descriptor, 60U, 0U),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_write(tx_descriptor, payload.data(),
+                                  payload.size(), &bytes_written),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_poll_all(results.data(), results.size(), &count),
+              SERIAL_DRIVER_OK);
+    ASSERT_NE(find(tx_descriptor), nullptr);
+    EXPECT_EQ(find(tx_descriptor)->tx_bytes, 60U);
+    EXPECT_EQ(find(tx_descriptor)->status, SERIAL_DRIVER_OK);
+    EXPECT_EQ(find(rx_descriptor), nullptr);
+    ASSERT_EQ(serial_driver_poll_all(results.data(), results.size(), &count),
+              SERIAL_DRIVER_OK);
+    ASSERT_NE(find(tx_descriptor), nullptr);
+    EXPECT_EQ(find(tx_descriptor)->tx_bytes, 40U);
+    ASSERT_EQ(serial_driver_poll_all(results.data(), results.size(), &count),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(find(tx_descriptor), nullptr);
+    EXPECT_EQ(uart_fifo_map.write_fifos[kTxPort].count, payload.size());
+
+    /* RX work is flagged by notify and kept while the FIFO holds data. */
+    for (size_t i = 0U; i < 10U; ++i)
+    {
+        FifoPush(&uart_fifo_map.read_fifos[kRxPort], static_cast<uint8_t>(i));
+    }
+    ASSERT_EQ(serial_driver_set_poll_budget(rx_descriptor, 0U, 6U),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_notify_rx(rx_descriptor), SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_poll_all(results.data(), results.size(), &count),
+              SERIAL_DRIVER_OK);
+    ASSERT_NE(find(rx_descriptor), nullptr);
+    EXPECT_EQ(find(rx_descriptor)->rx_bytes, 6U);
+    ASSERT_EQ(serial_driver_poll_all(results.data(), results.size(), &count),
+              SERIAL_DRIVER_OK);
+    ASSERT_NE(find(rx_descriptor), nullptr);
+    EXPECT_EQ(find(rx_descriptor)->rx_bytes, 4U);
+
+    std::array<uint8_t, 10> received{};
+    size_t bytes_read = 0U;
+    ASSERT_EQ(serial_driver_read(rx_descriptor, received.data(),
+                                 received.size(), &bytes_read),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(bytes_read, received.size());
+    EXPECT_EQ(received[9], 9U);
+
+    /* Ports beyond the result capacity stay pending for the next call. */
+    ASSERT_EQ(serial_driver_write(tx_descriptor, payload.data(), 1U,
+                                  &bytes_written),
+              SERIAL_DRIVER_OK);
+    FifoPush(&uart_fifo_map.read_fifos[kRxPort], 0x42U);
+    ASSERT_EQ(serial_driver_notify_rx(rx_descriptor), SERIAL_DRIVER_OK);
+    size_t serviced = 0U;
+    for (size_t round = 0U; round < UART_DEVICE_COUNT + 2U; ++round)
+    {
+        ASSERT_EQ(serial_driver_poll_all(results.data(), 1U, &count),
+                  SERIAL_DRIVER_OK);
+        ASSERT_LE(count, 1U);
+        if (find(tx_descriptor) != nullptr || find(rx_descriptor) != nullptr)
+        {
+            serviced += 1U;
+        }
+    }
+    EXPECT_EQ(serviced, 2U);
+    EXPECT_EQ(uart_fifo_map.read_fifos[kRxPort].count, 0U);
+}
+
+TEST_F(SerialDriverApiTest, FullDuplexPolicyBoundsRxLatencyUnderTxLoad)
+{
+    constexpr size_t kPort = SERIAL_PORT_1;
+    constexpr size_t kTicks = 200U;
+    constexpr size_t kLineBytesPerTick = 64U;
+    constexpr size_t kRxBytesPerTick = 16U;
+    std::array<uint8_t, SERIAL_QUEUE_FIXED_SIZE_BYTES> filler{};
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    EXPECT_EQ(serial_driver_set_poll_policy(
+                  descriptor, static_cast<serial_poll_policy_t>(9)),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_set_poll_policy(SERIAL_DESCRIPTOR_INVALID,
+                                            SERIAL_POLL_POLICY_ALTERNATE),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+
+    /*
+     * Each tick the line drains part of the write FIFO and delivers RX bytes
+     * stamped with the tick; TX is topped up so it never empties. Returns the
+     * worst RX latency in ticks, or kTicks if the read FIFO overflowed.
+     */
+    auto run = [&](serial_poll_policy_t policy) -> size_t {
+        uint8_t received[UART_DEVICE_FIFO_SIZE_BYTES] = {};
+        size_t worst = 0U;
+
+        EXPECT_EQ(serial_driver_set_poll_policy(descriptor, policy),
+                  SERIAL_DRIVER_OK);
+        ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+        ResetFifo(&uart_fifo_map.read_fifos[kPort]);
+
+        for (size_t tick = 0U; tick < kTicks; ++tick)
+        {
+            size_t moved = 0U;
+            size_t tx_bytes = 0U;
+            size_t rx_bytes = 0U;
+
+            (void)serial_driver_write(descriptor, filler.data(), filler.size(),
+                                      &moved);
+            for (size_t i = 0U; i < kLineBytesPerTick &&
+                                !FifoIsEmpty(&uart_fifo_map.write_fifos[kPort]);
+                 ++i)
+            {
+                (void)FifoPop(&uart_fifo_map.write_fifos[kPort]);
+            }
+            for (size_t i = 0U; i < kRxBytesPerTick; ++i)
+            {
+                if (FifoIsFull(&uart_fifo_map.read_fifos[kPort]))
+                {
+                    return kTicks;
+                }
+                FifoPush(&uart_fifo_map.read_fifos[kPort],
+                         static_cast<uint8_t>(tick));
+            }
+
+            EXPECT_EQ(serial_driver_poll(descriptor, UART_DEVICE_FIFO_SIZE_BYTES,
+                                         UART_DEVICE_FIFO_SIZE_BYTES, &tx_bytes,
+                                         &rx_bytes),
+                      SERIAL_DRIVER_OK);
+            while (serial_driver_read(descriptor, received, sizeof(received),
+                                      &moved) == SERIAL_DRIVER_OK)
+            {
+                for (size_t i = 0U; i < moved; ++i)
+                {
+                    worst = std::max<size_t>(worst, tick - received[i]);
+                }
+            }
+        }
+        return worst;
+    };
+
+    EXPECT_EQ(run(SERIAL_POLL_POLICY_TX_FIRST), kTicks);
+    EXPECT_EQ(run(SERIAL_POLL_POLICY_ALTERNATE), 0U);
+    EXPECT_EQ(run(SERIAL_POLL_POLICY_RX_PRIORITY), 0U);
+}
+
+TEST_F(SerialDriverApiTest, MmioBurstMovesBytesThroughDirectFifoWindow)
+{
+    constexpr size_t kPort = SERIAL_PORT_6;
+    xr17c358_channel_register_map_t &registers = g_test_registers[kPort];
+    std::vector<uint8_t> payload(300U);
+    uint8_t received[XR17V358_FIFO_DEPTH] = {};
+    size_t moved = 0U;
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+
+    for (size_t i = 0U; i < payload.size(); ++i)
+    {
+        payload[i] = static_cast<uint8_t>((i * 7U) + 3U);
+    }
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    EXPECT_EQ(serial_driver_set_data_path(
+                  descriptor, static_cast<serial_data_path_t>(7)),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_set_data_path(SERIAL_DESCRIPTOR_INVALID,
+                                          SERIAL_DATA_PATH_MMIO_BURST),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+    ASSERT_EQ(serial_driver_set_data_path(descriptor,
+                                          SERIAL_DATA_PATH_MMIO_BURST),
+              SERIAL_DRIVER_OK);
+
+    ASSERT_EQ(serial_driver_write(descriptor, payload.data(), payload.size(),
+                                  &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(moved, payload.size());
+
+    /* TXCNT says 56 bytes are still queued in the device: 200 free. */
+    registers.uart.txcnt_or_txtrg.txcnt = 56U;
+    ASSERT_EQ(serial_driver_poll(descriptor, payload.size(), 0U, &tx_bytes,
+                                 &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(tx_bytes, 200U);
+    for (size_t i = 0U; i < tx_bytes; ++i)
+    {
+        ASSERT_EQ(registers.fifo_data.tx_data[i], payload[i]) << i;
+    }
+    EXPECT_TRUE(FifoIsEmpty(&uart_fifo_map.write_fifos[kPort]));
+
+    registers.uart.txcnt_or_txtrg.txcnt = 0U;
+    ASSERT_EQ(serial_driver_poll(descriptor, payload.size(), 0U, &tx_bytes,
+                                 &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(tx_bytes, 100U);
+    for (size_t i = 0U; i < tx_bytes; ++i)
+    {
+        ASSERT_EQ(registers.fifo_data.tx_data[i], payload[200U + i]) << i;
+    }
+
+    /* RXCNT reports 255 bytes; the budget caps the first burst. */
+    for (size_t i = 0U; i < XR17V358_FIFO_DEPTH; ++i)
+    {
+        registers.fifo_data.rx_data[i] = static_cast<uint8_t>(0xFFU - i);
+    }
+    registers.uart.rxcnt_or_rxtrg.rxcnt = 255U;
+    ASSERT_EQ(serial_driver_poll(descriptor, 0U, 13U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(rx_bytes, 13U);
+    ASSERT_EQ(serial_driver_read(descriptor, received, sizeof(received),
+                                 &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(moved, 13U);
+    for (size_t i = 0U; i < moved; ++i)
+    {
+        EXPECT_EQ(received[i], static_cast<uint8_t>(0xFFU - i));
+    }
+
+    ASSERT_EQ(serial_driver_poll(descriptor, 0U, XR17V358_FIFO_DEPTH,
+                                 &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(rx_bytes, 255U);
+    ASSERT_EQ(serial_driver_read(descriptor, received, sizeof(received),
+                                 &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(moved, 255U);
+    for (size_t i = 0U; i < moved; ++i)
+    {
+        ASSERT_EQ(received[i], static_cast<uint8_t>(0xFFU - i)) << i;
+    }
+    EXPECT_TRUE(FifoIsEmpty(&uart_fifo_map.read_fifos[kPort]));
+}
+
+TEST_F(SerialDriverApiTest, StatusWindowReportsErroredBytesOutOfBand)
+{
+    constexpr size_t kPort = SERIAL_PORT_4;
+    xr17c358_channel_register_map_t &registers = g_test_registers[kPort];
+    std::array<serial_rx_error_t, SERIAL_RX_ERROR_LOG_DEPTH + 4U> errors{};
+    uint8_t received[XR17V358_FIFO_DEPTH] = {};
+    size_t moved = 0U;
+    size_t count = 0U;
+    uint64_t dropped = 0U;
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_EQ(serial_driver_set_data_path(
+                  descriptor, SERIAL_DATA_PATH_MMIO_BURST_WITH_STATUS),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_read_rx_errors(descriptor, nullptr, 1U, &count,
+                                           &dropped),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_read_rx_errors(descriptor, errors.data(),
+                                           errors.size(), nullptr, &dropped),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_read_rx_errors(SERIAL_DESCRIPTOR_INVALID,
+                                           errors.data(), errors.size(),
+                                           &count, &dropped),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+
+    for (size_t i = 0U; i < XR17V358_FIFO_DEPTH; ++i)
+    {
+        registers.fifo_data_with_status.data[i] = static_cast<uint8_t>(i);
+        registers.fifo_data_with_status.lsr_status[i] =
+            UART_LSR_DATA_READY_BIT;
+    }
+    registers.fifo_data_with_status.lsr_status[3] |= UART_LSR_PARITY_BIT;
+    registers.fifo_data_with_status.lsr_status[64] |=
+        UART_LSR_OVERRUN_BIT | UART_LSR_FRAMING_BIT;
+    registers.fifo_data_with_status.lsr_status[199] |= UART_LSR_BREAK_BIT;
+    registers.uart.rxcnt_or_rxtrg.rxcnt = 200U;
+
+    ASSERT_EQ(serial_driver_poll(descriptor, 0U, XR17V358_FIFO_DEPTH,
+                                 &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(rx_bytes, 200U);
+    ASSERT_EQ(serial_driver_read(descriptor, received, sizeof(received),
+                                 &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(moved, 200U);
+    for (size_t i = 0U; i < moved; ++i)
+    {
+        ASSERT_EQ(received[i], static_cast<uint8_t>(i)) << i;
+    }
+
+    ASSERT_EQ(serial_driver_read_rx_errors(descriptor, errors.data(), 2U,
+                                           &count, &dropped),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(count, 2U);
+    EXPECT_EQ(dropped, 0U);
+    EXPECT_EQ(errors[0].offset, 3U);
+    EXPECT_EQ(errors[0].error, UART_ERROR_PARITY);
+    EXPECT_EQ(errors[1].offset, 64U);
+    EXPECT_EQ(errors[1].error, UART_ERROR_OVERRUN);
+    EXPECT_EQ(errors[1].lsr, UART_LSR_DATA_READY_BIT | UART_LSR_OVERRUN_BIT |
+                                 UART_LSR_FRAMING_BIT);
+    ASSERT_EQ(serial_driver_read_rx_errors(descriptor, errors.data(),
+                                           errors.size(), &count, &dropped),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(count, 1U);
+    EXPECT_EQ(errors[0].offset, 199U);
+    EXPECT_EQ(errors[0].error, UART_ERROR_FRAMING);
+
+    /* A burst of errors past the log depth is counted, not stored. */
+    for (size_t i = 0U; i < 20U; ++i)
+    {
+        registers.fifo_data_with_status.lsr_status[i] =
+            UART_LSR_DATA_READY_BIT | UART_LSR_PARITY_BIT;
+    }
+    registers.uart.rxcnt_or_rxtrg.rxcnt = 20U;
+    ASSERT_EQ(serial_driver_poll(descriptor, 0U, XR17V358_FIFO_DEPTH,
+                                 &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(rx_bytes, 20U);
+    ASSERT_EQ(serial_driver_read_rx_errors(descriptor, errors.data(),
+                                           errors.size(), &count, &dropped),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(count, static_cast<size_t>(SERIAL_RX_ERROR_LOG_DEPTH));
+    EXPECT_EQ(dropped, 20U - SERIAL_RX_ERROR_LOG_DEPTH);
+    for (size_t i = 0U; i < count; ++i)
+    {
+        EXPECT_EQ(errors[i].offset, 200U + i);
+    }
+}
+
+TEST_F(SerialDriverApiTest, InterruptDispatchTouchesOnlyFlaggedChannels)
+{
+    xr17v358_device_config_registers_t device_config{};
+    std::array<serial_poll_result_t, UART_DEVICE_COUNT> results{};
+    std::array<serial_rx_error_t, 4U> errors{};
+    size_t count = 0U;
+    uint32_t channels = 0U;
+    uint64_t dropped = 0U;
+
+    const serial_descriptor_t rx_port =
+        serial_port_init(SERIAL_PORT_2, UART_PORT_MODE_SERIAL);
+    const serial_descriptor_t discrete_port =
+        serial_port_init(SERIAL_PORT_3, UART_PORT_MODE_DISCRETE);
+    const serial_descriptor_t tx_port =
+        serial_port_init(SERIAL_PORT_5, UART_PORT_MODE_SERIAL);
+    const serial_descriptor_t idle_port =
+        serial_port_init(SERIAL_PORT_6, UART_PORT_MODE_SERIAL);
+    ASSERT_NE(rx_port, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_NE(discrete_port, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_NE(tx_port, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_NE(idle_port, SERIAL_DESCRIPTOR_INVALID);
+
+    EXPECT_EQ(serial_driver_handle_interrupt(0U, nullptr, &channels),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_handle_interrupt(0U, &device_config, nullptr),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_service_event(0U, &device_config, nullptr, 1U,
+                                          &count),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    /* One card: ports 0-7 only. */
+    EXPECT_EQ(serial_driver_handle_interrupt(1U, &device_config, &channels),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+
+    /* Data sits in both read FIFOs, but nothing has raised an interrupt. */
+    for (uint8_t value = 0U; value < 4U; ++value)
+    {
+        FifoPush(&uart_fifo_map.read_fifos[SERIAL_PORT_2], value);
+        FifoPush(&uart_fifo_map.read_fifos[SERIAL_PORT_6], value);
+    }
+    ASSERT_EQ(serial_driver_service_event(0U, &device_config, results.data(),
+                                          results.size(), &count),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(count, 0U);
+
+    /* Channel 2: RX + line status, 3: RX time-out, 5: TX empty. */
+    const uint32_t sources =
+        (XR17V358_INT_SOURCE_RX_LINE_STATUS << (2U * XR17V358_INT_SOURCE_BITS)) |
+        (XR17V358_INT_SOURCE_RX_TIMEOUT << (3U * XR17V358_INT_SOURCE_BITS)) |
+        (XR17V358_INT_SOURCE_TX_EMPTY << (5U * XR17V358_INT_SOURCE_BITS));
+    device_config.generic.int0 = static_cast<uint8_t>(
+        XR17V358_INT0_CHANNEL_BIT(2U) | XR17V358_INT0_CHANNEL_BIT(3U) |
+        XR17V358_INT0_CHANNEL_BIT(5U));
+    device_config.generic.int1 = static_cast<uint8_t>(sources);
+    device_config.generic.int2 = static_cast<uint8_t>(sources >> 8U);
+    device_config.generic.int3 = static_cast<uint8_t>(sources >> 16U);
+    g_test_registers[SERIAL_PORT_2].uart.lsr =
+        UART_LSR_DATA_READY_BIT | UART_LSR_PARITY_BIT;
+
+    ASSERT_EQ(serial_driver_service_event(0U, &device_config, results.data(),
+                                          results.size(), &count),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(count, 2U);
+    EXPECT_EQ(results[0].descriptor, rx_port);
+    EXPECT_EQ(results[0].rx_bytes, 4U);
+    EXPECT_EQ(results[1].descriptor, tx_port);
+    EXPECT_EQ(results[1].tx_bytes, 0U);
+    EXPECT_EQ(uart_fifo_map.read_fifos[SERIAL_PORT_6].count, 4U);
+
+    ASSERT_EQ(serial_driver_read_rx_errors(rx_port, errors.data(),
+                                           errors.size(), &count, &dropped),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(count, 1U);
+    EXPECT_EQ(errors[0].error, UART_ERROR_PARITY);
+    EXPECT_EQ(errors[0].offset, 0U);
+
+    /* Shared line, someone else's interrupt. */
+    device_config.generic.int0 = 0U;
+    ASSERT_EQ(serial_driver_handle_interrupt(0U, &device_config, &channels),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(channels, 0U);
+}
+
+TEST_F(SerialDriverApiTest, FifoTriggersAndProfilesProgramTableD)
+{
+    constexpr size_t kPort = SERIAL_PORT_3;
+    xr17c358_channel_register_map_t &registers = g_test_registers[kPort];
+    std::array<serial_poll_result_t, UART_DEVICE_COUNT> results{};
+    std::vector<uint8_t> payload(600U, 0x5AU);
+    size_t moved = 0U;
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    EXPECT_EQ(serial_driver_set_fifo_triggers(descriptor, 16U, 0U),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_set_fifo_triggers(SERIAL_DESCRIPTOR_INVALID, 16U,
+                                              32U),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+    EXPECT_EQ(serial_driver_apply_fifo_profile(
+                  descriptor, static_cast<serial_fifo_profile_t>(5)),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+
+    /* Unrelated FCTR/EFR bits survive; EFR[4] is only set during the update. */
+    registers.uart.efr = 0x20U;
+    registers.uart.fctr = 0x05U;
+    ASSERT_EQ(serial_driver_set_fifo_triggers(descriptor, 16U, 96U),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.efr, 0x20U);
+    EXPECT_EQ(registers.uart.fctr, 0x05U | XR17V358_FCTR_TRIGGER_TABLE_D);
+    EXPECT_EQ(registers.uart.txcnt_or_txtrg.txtrg, 16U);
+    EXPECT_EQ(registers.uart.rxcnt_or_rxtrg.rxtrg, 96U);
+
+    ASSERT_EQ(serial_driver_apply_fifo_profile(descriptor,
+                                               SERIAL_FIFO_PROFILE_LATENCY),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.txcnt_or_txtrg.txtrg, 128U);
+    EXPECT_EQ(registers.uart.rxcnt_or_rxtrg.rxtrg, 8U);
+    ASSERT_EQ(serial_driver_write(descriptor, payload.data(), payload.size(),
+                                  &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_poll_all(results.data(), results.size(), &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(moved, 1U);
+    EXPECT_EQ(results[0].tx_bytes, 64U);
+
+    ASSERT_EQ(serial_driver_apply_fifo_profile(descriptor,
+                                               SERIAL_FIFO_PROFILE_THROUGHPUT),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.txcnt_or_txtrg.txtrg, 32U);
+    EXPECT_EQ(registers.uart.rxcnt_or_rxtrg.rxtrg, 224U);
+    ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+    ASSERT_EQ(serial_driver_poll_all(results.data(), results.size(), &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(moved, 1U);
+    EXPECT_EQ(results[0].tx_bytes, UART_DEVICE_FIFO_SIZE_BYTES);
+}
+
+TEST_F(SerialDriverApiTest, FlowControlModesProgramEfrAndDriveRts)
+{
+    constexpr size_t kPort = SERIAL_PORT_7;
+    xr17c358_channel_register_map_t &registers = g_test_registers[kPort];
+    std::array<serial_poll_result_t, UART_DEVICE_COUNT> results{};
+    serial_flow_control_config_t config{};
+    uint8_t scratch[600] = {};
+    size_t moved = 0U;
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    EXPECT_EQ(serial_driver_set_flow_control(descriptor, nullptr),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    config.mode = static_cast<serial_flow_control_t>(9);
+    EXPECT_EQ(serial_driver_set_flow_control(descriptor, &config),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    config.mode = SERIAL_FLOW_CONTROL_SW_RTS_CTS;
+    config.rts_high_water = 200U;
+    config.rts_low_water = 200U;
+    EXPECT_EQ(serial_driver_set_flow_control(descriptor, &config),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+
+    /* Hardware modes do not use the watermarks, so they are not checked. */
+    config.mode = SERIAL_FLOW_CONTROL_HW_RTS_CTS;
+    ASSERT_EQ(serial_driver_set_flow_control(descriptor, &config),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.efr,
+              XR17V358_EFR_AUTO_CTS_BIT | XR17V358_EFR_AUTO_RTS_BIT);
+    EXPECT_NE(registers.uart.mcr & UART_MCR_RTS_BIT, 0U);
+
+    config.mode = SERIAL_FLOW_CONTROL_HW_XON_XOFF;
+    ASSERT_EQ(serial_driver_set_flow_control(descriptor, &config),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.efr, XR17V358_EFR_SW_FLOW_XON1_XOFF1);
+    EXPECT_EQ(registers.uart.flow_control_3.xon1, UART_XON_CHAR);
+    EXPECT_EQ(registers.uart.flow_control_1.xoff1, UART_XOFF_CHAR);
+
+    /* Software RTS follows the RX queue: drop at 600 bytes, raise at 200. */
+    config.mode = SERIAL_FLOW_CONTROL_SW_RTS_CTS;
+    config.rts_high_water = 600U;
+    config.rts_low_water = 200U;
+    ASSERT_EQ(serial_driver_set_flow_control(descriptor, &config),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.efr, 0U);
+    for (size_t burst = 0U; burst < 3U; ++burst)
+    {
+        EXPECT_NE(registers.uart.mcr & UART_MCR_RTS_BIT, 0U) << burst;
+        while (!FifoIsFull(&uart_fifo_map.read_fifos[kPort]))
+        {
+            FifoPush(&uart_fifo_map.read_fifos[kPort], 0xA5U);
+        }
+        ASSERT_EQ(serial_driver_poll(descriptor, 0U,
+                                     UART_DEVICE_FIFO_SIZE_BYTES, &tx_bytes,
+                                     &rx_bytes),
+                  SERIAL_DRIVER_OK);
+        EXPECT_EQ(rx_bytes, UART_DEVICE_FIFO_SIZE_BYTES);
+    }
+    EXPECT_EQ(registers.uart.mcr & UART_MCR_RTS_BIT, 0U);
+
+    /* No new RX arrives while throttled; poll_all still releases RTS. */
+    ASSERT_EQ(serial_driver_read(descriptor, scratch, sizeof(scratch), &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_poll_all(results.data(), results.size(), &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(moved, 1U);
+    EXPECT_EQ(results[0].descriptor, descriptor);
+    EXPECT_NE(registers.uart.mcr & UART_MCR_RTS_BIT, 0U);
+
+    /* TX waits for CTS. */
+    ASSERT_EQ(serial_driver_write(descriptor, scratch, 32U, &moved),
+              SERIAL_DRIVER_OK);
+    registers.uart.msr_or_rs485dly.msr = 0U;
+    ASSERT_EQ(serial_driver_poll(descriptor, 32U, 0U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(tx_bytes, 0U);
+    registers.uart.msr_or_rs485dly.msr = UART_MSR_CTS_BIT;
+    ASSERT_EQ(serial_driver_poll(descriptor, 32U, 0U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(tx_bytes, 32U);
+}
+
+TEST_F(SerialDriverApiTest, SoftwareXonXoffFiltersRxGatesTxAndThrottles)
+{
+    constexpr size_t kPort = SERIAL_PORT_6;
+    xr17c358_channel_register_map_t &registers = g_test_registers[kPort];
+    uart_byte_fifo_t *const read_fifo = &uart_fifo_map.read_fifos[kPort];
+    uart_byte_fifo_t *const write_fifo = &uart_fifo_map.write_fifos[kPort];
+    std::array<serial_poll_result_t, UART_DEVICE_COUNT> results{};
+    serial_flow_control_config_t config{};
+    const uint8_t payload[4] = {0x01U, 0x02U, 0x03U, 0x04U};
+    uint8_t scratch[600] = {};
+    size_t moved = 0U;
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    config.mode = SERIAL_FLOW_CONTROL_SW_XON_XOFF;
+    config.xoff_char = UART_XON_CHAR;
+    EXPECT_EQ(serial_driver_set_flow_control(descriptor, &config),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    config.xoff_char = 0U;
+    config.rts_high_water = 600U;
+    config.rts_low_water = 200U;
+    ASSERT_EQ(serial_driver_set_flow_control(descriptor, &config),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.efr, 0U);
+
+    /* XOFF is consumed, not queued, and holds TX. */
+    FifoPush(read_fifo, 'a');
+    FifoPush(read_fifo, UART_XOFF_CHAR);
+    FifoPush(read_fifo, 'b');
+    ASSERT_EQ(serial_driver_poll(descriptor, 0U, 8U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(rx_bytes, 2U);
+    ASSERT_EQ(serial_driver_read(descriptor, scratch, sizeof(scratch), &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(moved, 2U);
+    EXPECT_EQ(scratch[0], 'a');
+    EXPECT_EQ(scratch[1], 'b');
+
+    /* While held, a TX-first poll still reaches RX and sees the XON. */
+    ASSERT_EQ(serial_driver_write(descriptor, payload, sizeof(payload),
+                                  &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_poll(descriptor, 8U, 8U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(tx_bytes, 0U);
+    EXPECT_TRUE(FifoIsEmpty(write_fifo));
+    FifoPush(read_fifo, UART_XON_CHAR);
+    ASSERT_EQ(serial_driver_poll(descriptor, 8U, 8U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(rx_bytes, 0U);
+    ASSERT_EQ(serial_driver_poll(descriptor, 8U, 8U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(tx_bytes, sizeof(payload));
+    ResetFifo(write_fifo);
+
+    /* Crossing 600 queued bytes sends XOFF; draining to 200 sends XON. */
+    for (size_t burst = 0U; burst < 3U; ++burst)
+    {
+        EXPECT_TRUE(FifoIsEmpty(write_fifo)) << burst;
+        while (!FifoIsFull(read_fifo))
+        {
+            FifoPush(read_fifo, 0xA5U);
+        }
+        ASSERT_EQ(serial_driver_poll(descriptor, 0U,
+                                     UART_DEVICE_FIFO_SIZE_BYTES, &tx_bytes,
+                                     &rx_bytes),
+                  SERIAL_DRIVER_OK);
+        EXPECT_EQ(rx_bytes, UART_DEVICE_FIFO_SIZE_BYTES);
+    }
+    ASSERT_EQ(write_fifo->count, 1U);
+    EXPECT_EQ(FifoPop(write_fifo), UART_XOFF_CHAR);
+
+    ASSERT_EQ(serial_driver_read(descriptor, scratch, sizeof(scratch), &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_poll_all(results.data(), results.size(), &moved),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(write_fifo->count, 1U);
+    EXPECT_EQ(FifoPop(write_fifo), UART_XON_CHAR);
+}
+
+TEST_F(SerialDriverApiTest, PortConfigureProgramsDivisorSamplingAndLcr)
+{
+    static_assert(SERIAL_DRIVER_UART_CLOCK_HZ == 125000000UL,
+                  "expected divisors below assume a 125 MHz UART clock");
+    constexpr size_t kPort = SERIAL_PORT_5;
+    constexpr uint8_t kChannelBit = 1U << kPort;
+    xr17c358_channel_register_map_t &registers = g_test_registers[kPort];
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    EXPECT_EQ(serial_port_configure(descriptor, 0U, 8U, SERIAL_PARITY_NONE,
+                                    SERIAL_STOP_BITS_1),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_port_configure(descriptor, 9600U, 9U, SERIAL_PARITY_NONE,
+                                    SERIAL_STOP_BITS_1),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_port_configure(descriptor, 9600U, 8U,
+                                    static_cast<serial_parity_t>(8),
+                                    SERIAL_STOP_BITS_1),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_port_configure(descriptor, 9600U, 8U, SERIAL_PARITY_NONE,
+                                    static_cast<serial_stop_bits_t>(3)),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_port_configure(descriptor, 50000000U, 8U,
+                                    SERIAL_PARITY_NONE, SERIAL_STOP_BITS_1),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_port_configure(SERIAL_DESCRIPTOR_INVALID, 9600U, 8U,
+                                    SERIAL_PARITY_NONE, SERIAL_STOP_BITS_1),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+
+    /* 300 baud at 16X: divisor 26042 spans both latch bytes. */
+    ASSERT_EQ(serial_port_configure(descriptor, 300U, 7U, SERIAL_PARITY_ODD,
+                                    SERIAL_STOP_BITS_1),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.data.dll, 26042U & 0xFFU);
+    EXPECT_EQ(registers.uart.interrupt_enable.dlm, 26042U >> 8U);
+    EXPECT_EQ(registers.uart.lcr, 0x02U | UART_LCR_PARITY_ENABLE_BIT);
+
+    ASSERT_EQ(serial_port_configure(descriptor, 115200U, 8U,
+                                    SERIAL_PARITY_NONE, SERIAL_STOP_BITS_1),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.data.dll, 68U);
+    EXPECT_EQ(registers.uart.interrupt_enable.dlm, 0U);
+    EXPECT_EQ(registers.uart.lcr, 0x03U);
+    EXPECT_EQ(registers.device_config.generic.mode_8x & kChannelBit, 0U);
+    EXPECT_EQ(registers.device_config.generic.mode_4x & kChannelBit, 0U);
+
+    /* 16X cannot get within 3% of 921600 from 125 MHz; 8X can. */
+    ASSERT_EQ(serial_port_configure(descriptor, 921600U, 8U,
+                                    SERIAL_PARITY_EVEN, SERIAL_STOP_BITS_2),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.data.dll, 17U);
+    EXPECT_EQ(registers.uart.lcr,
+              0x03U | UART_LCR_STOP_BITS_BIT | UART_LCR_PARITY_ENABLE_BIT |
+                  UART_LCR_EVEN_PARITY_BIT);
+    EXPECT_EQ(registers.device_config.generic.mode_8x & kChannelBit,
+              kChannelBit);
+    EXPECT_EQ(registers.device_config.generic.mode_4x & kChannelBit, 0U);
+
+    ASSERT_EQ(serial_port_configure(descriptor, 1500000U, 8U,
+                                    SERIAL_PARITY_NONE, SERIAL_STOP_BITS_1),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.data.dll, 21U);
+    EXPECT_EQ(registers.device_config.generic.mode_8x & kChannelBit, 0U);
+    EXPECT_EQ(registers.device_config.generic.mode_4x & kChannelBit,
+              kChannelBit);
+
+    /* Same settings write nothing; a format change rewrites only LCR. */
+    registers.uart.data.dll = 0xEEU;
+    ASSERT_EQ(serial_port_configure(descriptor, 1500000U, 8U,
+                                    SERIAL_PARITY_NONE, SERIAL_STOP_BITS_1),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.data.dll, 0xEEU);
+    ASSERT_EQ(serial_port_configure(descriptor, 1500000U, 8U,
+                                    SERIAL_PARITY_MARK, SERIAL_STOP_BITS_1),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.data.dll, 0xEEU);
+    EXPECT_EQ(registers.uart.lcr, 0x03U | UART_LCR_PARITY_ENABLE_BIT |
+                                      UART_LCR_STICK_PARITY_BIT);
+
+    /* Rates outside the table use the same rule at runtime. */
+    ASSERT_EQ(serial_port_configure(descriptor, 250000U, 8U,
+                                    SERIAL_PARITY_NONE, SERIAL_STOP_BITS_1),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(registers.uart.data.dll, 31U);
+}
+
+TEST_F(SerialDriverApiTest, WritevAndReadvGatherSegmentsAcrossRingWrap)
+{
+    constexpr size_t kPort = SERIAL_PORT_1;
+    static uint8_t tx_storage[32];
+    static uint8_t rx_storage[32];
+    const std::array<uint8_t, 4> header{{0xA5U, 0x5AU, 0x00U, 0x0AU}};
+    std::array<uint8_t, 10> payload{};
+    const std::array<uint8_t, 2> crc{{0xC3U, 0x3CU}};
+    std::array<uint8_t, 20> filler{};
+    std::array<uint8_t, 5> first{};
+    std::array<uint8_t, 7> second{};
+    std::array<uint8_t, 10> third{};
+    serial_port_config_t config = {};
+    size_t bytes = 0U;
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+
+    for (size_t i = 0U; i < payload.size(); ++i)
+    {
+        payload[i] = static_cast<uint8_t>(0x10U + i);
+    }
+
+    ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+    ResetFifo(&uart_fifo_map.read_fifos[kPort]);
+
+    config.mode = UART_PORT_MODE_SERIAL;
+    config.tx_storage = tx_storage;
+    config.tx_capacity = sizeof(tx_storage);
+    config.rx_storage = rx_storage;
+    config.rx_capacity = sizeof(rx_storage);
+    const serial_descriptor_t descriptor =
+        serial_port_init_ex(static_cast<serial_ports_t>(kPort), &config);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+
+    /* Move both rings 20 bytes in so the 16-byte frame wraps. */
+    ASSERT_EQ(serial_driver_write(descriptor, filler.data(), filler.size(),
+                                  &bytes),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_poll(descriptor, 64U, 0U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(MoveWriteToRead(kPort), filler.size());
+    ASSERT_EQ(serial_driver_poll(descriptor, 0U, 64U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_read(descriptor, filler.data(), filler.size(),
+                                 &bytes),
+              SERIAL_DRIVER_OK);
+
+    const std::array<serial_const_span_t, 4> frame{
+        {{header.data(), header.size()},
+         {nullptr, 0U},
+         {payload.data(), payload.size()},
+         {crc.data(), crc.size()}}};
+    ASSERT_EQ(serial_driver_writev(descriptor, frame.data(), frame.size(),
+                                   &bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(bytes, 16U);
+
+    /* 16 bytes free: a 20-byte frame is refused whole. */
+    const serial_const_span_t too_big[2] = {{filler.data(), 10U},
+                                            {filler.data(), 10U}};
+    bytes = 99U;
+    EXPECT_EQ(serial_driver_writev(descriptor, too_big, 2U, &bytes),
+              SERIAL_DRIVER_ERROR_TX_FULL);
+    EXPECT_EQ(bytes, 0U);
+
+    ASSERT_EQ(serial_driver_poll(descriptor, 64U, 0U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(tx_bytes, 16U);
+    ASSERT_EQ(MoveWriteToRead(kPort), 16U);
+    ASSERT_EQ(serial_driver_poll(descriptor, 0U, 64U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+
+    const std::array<serial_span_t, 3> split{{{first.data(), first.size()},
+                                              {second.data(), second.size()},
+                                              {third.data(), third.size()}}};
+    ASSERT_EQ(serial_driver_readv(descriptor, split.data(), split.size(),
+                                  &bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(bytes, 16U);
+
+    std::vector<uint8_t> expected(header.begin(), header.end());
+    expected.insert(expected.end(), payload.begin(), payload.end());
+    expected.insert(expected.end(), crc.begin(), crc.end());
+    std::vector<uint8_t> received(first.begin(), first.end());
+    received.insert(received.end(), second.begin(), second.end());
+    received.insert(received.end(), third.begin(), third.begin() + 4);
+    EXPECT_EQ(received, expected);
+    EXPECT_EQ(serial_driver_readv(descriptor, split.data(), split.size(),
+                                  &bytes),
+              SERIAL_DRIVER_ERROR_RX_EMPTY);
+
+    const serial_const_span_t missing_data = {nullptr, 1U};
+    EXPECT_EQ(serial_driver_writev(descriptor, &missing_data, 1U, &bytes),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_writev(descriptor, nullptr, 1U, &bytes),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_readv(descriptor, split.data(), split.size(),
+                                  nullptr),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+
+    ASSERT_EQ(serial_driver_set_write_mode(descriptor,
+                                           SERIAL_WRITE_MODE_MULTI_PRODUCER),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_writev(descriptor, frame.data(), frame.size(),
+                                   &bytes),
+              SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+}
+
+#if SERIAL_DRIVER_BLOCKING
+TEST_F(SerialDriverApiTest, TimedReadAndWriteParkUntilPollMovesData)
+{
+    constexpr size_t kPort = SERIAL_PORT_2;
+    static uint8_t tx_storage[16];
+    const std::array<uint8_t, 3> payload{{0x01U, 0x02U, 0x03U}};
+    std::array<uint8_t, 40> large{};
+    std::array<uint8_t, 8> received{};
+    serial_port_config_t config = {};
+    size_t bytes = 0U;
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+
+    ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+    ResetFifo(&uart_fifo_map.read_fifos[kPort]);
+
+    config.mode = UART_PORT_MODE_SERIAL;
+    config.tx_storage = tx_storage;
+    config.tx_capacity = sizeof(tx_storage);
+    const serial_descriptor_t descriptor =
+        serial_port_init_ex(static_cast<serial_ports_t>(kPort), &config);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+
+    EXPECT_EQ(serial_driver_read_timeout(descriptor, received.data(),
+                                         received.size(), &bytes, 0U),
+              SERIAL_DRIVER_ERROR_TIMEOUT);
+    const auto begin = std::chrono::steady_clock::now();
+    EXPECT_EQ(serial_driver_read_timeout(descriptor, received.data(),
+                                         received.size(), &bytes, 20U),
+              SERIAL_DRIVER_ERROR_TIMEOUT);
+    EXPECT_GE(std::chrono::steady_clock::now() - begin,
+              std::chrono::milliseconds(20));
+    EXPECT_EQ(serial_driver_read_timeout(SERIAL_DESCRIPTOR_INVALID,
+                                         received.data(), received.size(),
+                                         &bytes, 20U),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+
+    /* A parked reader is released by the poll that receives its bytes. */
+    serial_driver_error_t read_status = SERIAL_DRIVER_OK;
+    size_t read_bytes = 0U;
+    std::thread reader([&] {
+        read_status = serial_driver_read_timeout(
+            descriptor, received.data(), received.size(), &read_bytes, 10000U);
+    });
+    /* No ASSERT_* while the thread is joinable: an early return would
+     * destroy it unjoined and terminate the whole binary. */
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(serial_driver_write(descriptor, payload.data(), payload.size(),
+                                  &bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_poll(descriptor, 64U, 0U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(MoveWriteToRead(kPort), payload.size());
+    EXPECT_EQ(serial_driver_poll(descriptor, 0U, 64U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    reader.join();
+    EXPECT_EQ(read_status, SERIAL_DRIVER_OK);
+    ASSERT_EQ(read_bytes, payload.size());
+    EXPECT_TRUE(std::equal(payload.begin(), payload.end(), received.begin()));
+
+    /* A full ring: a timed-out write reports the bytes it did queue. */
+    EXPECT_EQ(serial_driver_write_timeout(descriptor, large.data(),
+                                          large.size(), &bytes, 5U),
+              SERIAL_DRIVER_ERROR_TIMEOUT);
+    EXPECT_EQ(bytes, sizeof(tx_storage));
+
+    /* A parked writer finishes as a poller drains the ring. */
+    std::atomic<bool> done{false};
+    serial_driver_error_t write_status = SERIAL_DRIVER_OK;
+    size_t written = 0U;
+    std::thread writer([&] {
+        write_status = serial_driver_write_timeout(
+            descriptor, large.data(), large.size(), &written, 10000U);
+        done = true;
+    });
+    /* Drain until the writer returns; past its own timeout it returns
+     * anyway, so the deadline only bounds a poll that stopped draining. */
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(15);
+    while (!done && std::chrono::steady_clock::now() < deadline)
+    {
+        (void)serial_driver_poll(descriptor, 64U, 0U, &tx_bytes, &rx_bytes);
+        ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+        std::this_thread::yield();
+    }
+    writer.join();
+    EXPECT_TRUE(done);
+    EXPECT_EQ(write_status, SERIAL_DRIVER_OK);
+    EXPECT_EQ(written, large.size());
+}
+#endif
+
+#if SERIAL_DRIVER_EVENTFD
+TEST_F(SerialDriverApiTest, EventFdSignalsOncePerBurstAtConfiguredLevels)
+{
+    constexpr size_t kPort = SERIAL_PORT_3;
+    const std::array<uint8_t, 3> payload{{0x31U, 0x32U, 0x33U}};
+    serial_event_config_t config = {};
+    uint64_t count = 0U;
+    uint32_t events = 0U;
+    size_t bytes = 0U;
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+    int fd = -1;
+
+    ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+    ResetFifo(&uart_fifo_map.read_fifos[kPort]);
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    EXPECT_EQ(serial_driver_ack_event_fd(descriptor, &events),
+              SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+    EXPECT_EQ(serial_driver_open_event_fd(descriptor, nullptr, &fd),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+
+    config.rx_threshold = 4U;
+    config.tx_low_water = 0U;
+    ASSERT_EQ(serial_driver_open_event_fd(descriptor, &config, &fd),
+              SERIAL_DRIVER_OK);
+    ASSERT_GE(fd, 0);
+    int again = -1;
+    ASSERT_EQ(serial_driver_open_event_fd(descriptor, &config, &again),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(again, fd);
+    EXPECT_EQ(read(fd, &count, sizeof(count)), -1);
+
+    /* Two drains to the low-water mark before the loop runs: one wakeup. */
+    for (int round = 0; round < 2; ++round)
+    {
+        ASSERT_EQ(serial_driver_write(descriptor, payload.data(),
+                                      payload.size(), &bytes),
+                  SERIAL_DRIVER_OK);
+        ASSERT_EQ(
+            serial_driver_poll(descriptor, 64U, 0U, &tx_bytes, &rx_bytes),
+            SERIAL_DRIVER_OK);
+    }
+    ASSERT_EQ(read(fd, &count, sizeof(count)),
+              static_cast<ssize_t>(sizeof(count)));
+    EXPECT_EQ(count, 1U);
+    ASSERT_EQ(serial_driver_ack_event_fd(descriptor, &events),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(events, static_cast<uint32_t>(SERIAL_EVENT_TX_READY));
+
+    /* RX below the threshold stays quiet; crossing it signals. */
+    ASSERT_EQ(MoveWriteToRead(kPort), 2U * payload.size());
+    ASSERT_EQ(serial_driver_poll(descriptor, 0U, 2U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(rx_bytes, 2U);
+    EXPECT_EQ(read(fd, &count, sizeof(count)), -1);
+    ASSERT_EQ(serial_driver_poll(descriptor, 0U, 64U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_ack_event_fd(descriptor, &events),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(events, static_cast<uint32_t>(SERIAL_EVENT_RX_READY |
+                                            SERIAL_EVENT_TX_READY));
+    EXPECT_EQ(read(fd, &count, sizeof(count)), -1);
+
+    ASSERT_EQ(serial_driver_close_event_fd(descriptor), SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_close_event_fd(descriptor),
+              SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+    EXPECT_EQ(serial_driver_ack_event_fd(descriptor, &events),
+              SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+}
+#endif
+
+#if SERIAL_DRIVER_BLOCKING
+TEST_F(SerialDriverApiTest, PollerThreadMovesDataAndBacksOffWhenIdle)
+{
+    constexpr size_t kPort = SERIAL_PORT_4;
+    const std::array<uint8_t, 3> incoming{{0x41U, 0x42U, 0x43U}};
+    const std::array<uint8_t, 2> outgoing{{0x51U, 0x52U}};
+    std::array<uint8_t, 8> received{};
+    serial_poller_config_t config = {};
+    serial_poller_stats_t stats = {};
+    size_t bytes = 0U;
+
+    ResetFifo(&uart_fifo_map.write_fifos[kPort]);
+    ResetFifo(&uart_fifo_map.read_fifos[kPort]);
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    for (const uint8_t value : incoming)
+    {
+        FifoPush(&uart_fifo_map.read_fifos[kPort], value);
+    }
+
+    config.cpu = 100000;
+    EXPECT_EQ(serial_driver_start_poller(&config),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_stop_poller(), SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+
+    config.cpu = -1;
+    config.spin_passes = 16U;
+    config.pause_passes = 16U;
+    config.yield_passes = 16U;
+    config.sleep_us = 50U;
+    ASSERT_EQ(serial_driver_start_poller(&config), SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_start_poller(&config),
+              SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+
+    ASSERT_EQ(serial_driver_read_timeout(descriptor, received.data(),
+                                         received.size(), &bytes, 5000U),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(bytes, incoming.size());
+    EXPECT_TRUE(std::equal(incoming.begin(), incoming.end(), received.begin()));
+
+    ASSERT_EQ(serial_driver_write(descriptor, outgoing.data(), outgoing.size(),
+                                  &bytes),
+              SERIAL_DRIVER_OK);
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    do
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ASSERT_EQ(serial_driver_get_poller_stats(&stats), SERIAL_DRIVER_OK);
+    } while ((stats.busy_passes < 2U || stats.sleeps == 0U) &&
+             std::chrono::steady_clock::now() < deadline);
+    ASSERT_EQ(serial_driver_stop_poller(), SERIAL_DRIVER_OK);
+
+    EXPECT_EQ(stats.busy_passes, 2U);
+    EXPECT_GT(stats.pauses, 0U);
+    EXPECT_GT(stats.yields, 0U);
+    EXPECT_GT(stats.sleeps, 0U);
+    EXPECT_GE(stats.passes, stats.busy_passes + 48U + stats.sleeps);
+    ASSERT_EQ(uart_fifo_map.write_fifos[kPort].count, outgoing.size());
+    EXPECT_EQ(FifoPop(&uart_fifo_map.write_fifos[kPort]), outgoing[0]);
+    EXPECT_EQ(FifoPop(&uart_fifo_map.write_fifos[kPort]), outgoing[1]);
+    EXPECT_EQ(serial_driver_get_poller_stats(nullptr),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+}
+
+TEST_F(SerialDriverApiTest, PollerRecordsServiceErrorAndDropsFailedPort)
+{
+    constexpr size_t kBadPort = SERIAL_PORT_5;
+    constexpr size_t kGoodPort = SERIAL_PORT_0;
+    const uint8_t outgoing = 0x6DU;
+    serial_poller_config_t config = {};
+    serial_poller_stats_t stats = {};
+    size_t bytes = 0U;
+
+    ResetFifo(&uart_fifo_map.write_fifos[kGoodPort]);
+    ResetFifo(&uart_fifo_map.read_fifos[kBadPort]);
+
+    const serial_descriptor_t bad = serial_port_init(
+        static_cast<serial_ports_t>(kBadPort), UART_PORT_MODE_SERIAL);
+    const serial_descriptor_t good = serial_port_init(
+        static_cast<serial_ports_t>(kGoodPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(bad, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_NE(good, SERIAL_DESCRIPTOR_INVALID);
+
+    /* A word-mode RX queue makes every service of the port fail. */
+    serial_queue_t *const rx_queue = uart_devices[kBadPort].rx_queue;
+    const serial_queue_mode_t rx_mode = rx_queue->mode;
+    rx_queue->mode = SERIAL_QUEUE_MODE_WORD;
+
+    config.cpu = -1;
+    config.spin_passes = 16U;
+    config.sleep_us = 50U;
+    ASSERT_EQ(serial_driver_start_poller(&config), SERIAL_DRIVER_OK);
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    do
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ASSERT_EQ(serial_driver_get_poller_stats(&stats), SERIAL_DRIVER_OK);
+    } while ((stats.errors == 0U || stats.sleeps == 0U) &&
+             std::chrono::steady_clock::now() < deadline);
+
+    /* The healthy port is still serviced after the other one failed. The
+     * FIFO belongs to the poller until it stops, so watch the TX queue. */
+    ASSERT_EQ(serial_driver_write(good, &outgoing, 1U, &bytes),
+              SERIAL_DRIVER_OK);
+    while (!serial_queue_is_empty(uart_devices[kGoodPort].tx_queue) &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(serial_driver_stop_poller(), SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_get_poller_stats(&stats), SERIAL_DRIVER_OK);
+    rx_queue->mode = rx_mode;
+
+    EXPECT_EQ(stats.errors, 1U);
+    EXPECT_EQ(stats.last_error, SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+    EXPECT_GT(stats.sleeps, 0U);
+    ASSERT_EQ(uart_fifo_map.write_fifos[kGoodPort].count, 1U);
+    EXPECT_EQ(FifoPop(&uart_fifo_map.write_fifos[kGoodPort]), outgoing);
+}
+#endif
+
+#if SERIAL_DRIVER_BLOCKING && SERIAL_DRIVER_EVENTFD
+TEST_F(SerialDriverApiTest, PoolKeepsPerPortOrderWhileWorkersSteal)
+{
+    constexpr size_t kBusyPort = SERIAL_PORT_6;
+    constexpr size_t kIdlePort = SERIAL_PORT_7;
+    constexpr size_t kBytes = 200U;
+    std::vector<uint8_t> outgoing(kBytes);
+    std::vector<uint8_t> received;
+    serial_pool_config_t config = {};
+    serial_poller_stats_t stats = {};
+    serial_event_config_t event_config = {};
+    uint32_t events = 0U;
+    size_t bytes = 0U;
+    int fd = -1;
+
+    ResetFifo(&uart_fifo_map.write_fifos[kBusyPort]);
+    ResetFifo(&uart_fifo_map.read_fifos[kBusyPort]);
+    ResetFifo(&uart_fifo_map.write_fifos[kIdlePort]);
+    ResetFifo(&uart_fifo_map.read_fifos[kIdlePort]);
+
+    const serial_descriptor_t busy = serial_port_init(
+        static_cast<serial_ports_t>(kBusyPort), UART_PORT_MODE_SERIAL);
+    const serial_descriptor_t idle = serial_port_init(
+        static_cast<serial_ports_t>(kIdlePort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(busy, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_NE(idle, SERIAL_DESCRIPTOR_INVALID);
+
+    /* One byte per service keeps the busy port pending for many passes, so
+     * the worker that owns only the idle port steals it. */
+    ASSERT_EQ(serial_driver_set_poll_budget(busy, 1U, 1U), SERIAL_DRIVER_OK);
+    for (size_t i = 0U; i < kBytes; ++i)
+    {
+        outgoing[i] = static_cast<uint8_t>(i);
+        FifoPush(&uart_fifo_map.read_fifos[kBusyPort],
+                 static_cast<uint8_t>(0xFFU - i));
+    }
+    ASSERT_EQ(
+        serial_driver_write(busy, outgoing.data(), outgoing.size(), &bytes),
+        SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_driver_open_event_fd(busy, &event_config, &fd),
+              SERIAL_DRIVER_OK);
+
+    EXPECT_EQ(serial_driver_start_pool(nullptr),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_start_pool(&config),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    config.worker_count = SERIAL_POOL_MAX_WORKERS + 1U;
+    EXPECT_EQ(serial_driver_start_pool(&config),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+
+    config.worker_count = 2U;
+    config.backoff.spin_passes = 64U;
+    config.backoff.sleep_us = 50U;
+    ASSERT_EQ(serial_driver_start_pool(&config), SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_start_poller(nullptr),
+              SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+    EXPECT_EQ(serial_driver_stop_poller(), SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+
+    while (received.size() < kBytes)
+    {
+        std::array<uint8_t, 32> chunk{};
+
+        ASSERT_EQ(serial_driver_read_timeout(busy, chunk.data(), chunk.size(),
+                                             &bytes, 5000U),
+                  SERIAL_DRIVER_OK);
+        received.insert(received.end(), chunk.begin(), chunk.begin() + bytes);
+    }
+    for (int attempt = 0; attempt < 500; ++attempt)
+    {
+        ASSERT_EQ(serial_driver_ack_event_fd(busy, &events), SERIAL_DRIVER_OK);
+        if ((events & SERIAL_EVENT_TX_READY) != 0U)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(serial_driver_get_pool_stats(2U, &stats),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    ASSERT_EQ(serial_driver_stop_pool(), SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_stop_pool(), SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+
+    uint64_t busy_passes = 0U;
+    for (size_t worker = 0U; worker < config.worker_count; ++worker)
+    {
+        ASSERT_EQ(serial_driver_get_pool_stats(worker, &stats),
+                  SERIAL_DRIVER_OK);
+        busy_passes += stats.busy_passes;
+    }
+    /* Every byte took its own service, whichever worker ran it. */
+    EXPECT_GE(busy_passes, kBytes);
+    EXPECT_EQ(serial_driver_get_poller_stats(&stats),
+              SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+
+    for (size_t i = 0U; i < kBytes; ++i)
+    {
+        ASSERT_EQ(received[i], static_cast<uint8_t>(0xFFU - i)) << i;
+    }
+    ASSERT_EQ(uart_fifo_map.write_fifos[kBusyPort].count, kBytes);
+    for (size_t i = 0U; i < kBytes; ++i)
+    {
+        ASSERT_EQ(FifoPop(&uart_fifo_map.write_fifos[kBusyPort]), outgoing[i])
+            << i;
+    }
+    EXPECT_EQ(serial_driver_close_event_fd(busy), SERIAL_DRIVER_OK);
+}
+
+TEST_F(SerialDriverApiTest, ResetRefusesWhilePollerRunsAndClosesEventFds)
+{
+    constexpr size_t kPort = SERIAL_PORT_2;
+    const uint8_t outgoing = 0x5AU;
+    serial_poller_config_t config = {};
+    serial_event_config_t event_config = {};
+    size_t bytes = 0U;
+    int fd = -1;
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_EQ(serial_driver_open_event_fd(descriptor, &event_config, &fd),
+              SERIAL_DRIVER_OK);
+
+    config.cpu = -1;
+    ASSERT_EQ(serial_driver_start_poller(&config), SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_reset(), SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+    ASSERT_EQ(serial_driver_stop_poller(), SERIAL_DRIVER_OK);
+
+    /* The refused reset left the port and its eventfd alone. */
+    EXPECT_EQ(serial_driver_write(descriptor, &outgoing, 1U, &bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_NE(fcntl(fd, F_GETFD), -1);
+
+    ASSERT_EQ(serial_driver_reset(), SERIAL_DRIVER_OK);
+    EXPECT_EQ(fcntl(fd, F_GETFD), -1);
+    EXPECT_EQ(serial_driver_write(descriptor, &outgoing, 1U, &bytes),
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+}
+#endif
@@ -9,7 +9,8 @@ extern "C"
 #include "device_driver/hw_abstraction.h"
 
     uart_error_t serial_driver_hw_map_uart(size_t port_index,
-                                           uart_device_t *uart_device);
+                                           uart_device_t *uart_device,
+                                           uart_device_info_t *device_info);
 }
 
 namespace
@@ -17,32 +18,38 @@ namespace
 
 xr17c358_channel_register_map_t g_registers[UART_DEVICE_COUNT]{};
 
-uart_error_t CoverageMapper(size_t port_index, uart_device_t *uart_device)
+uart_error_t CoverageMapper(size_t port_index, uart_device_t *uart_device,
+                            uart_device_info_t *device_info)
 {
 
-    if (uart_device == nullptr || port_index >= UART_DEVICE_COUNT)
+    if (uart_device == nullptr || device_info == nullptr ||
+        port_index >= UART_DEVICE_COUNT)
     {
         return UART_ERROR_INVALID_ARG;
     }
 
     std::memset(&g_registers[port_index], 0, sizeof(g_registers[port_index]));
     uart_device->registers = &g_registers[port_index];
-    uart_device->uart_base_address =
+    device_info->uart_base_address =
         reinterpret_cast<uintptr_t>(&g_registers[port_index]);
-    uart_device->device_name = "coverage-uart";
+    device_info->device_name = "coverage-uart";
     return UART_ERROR_NONE;
 }
 
-uart_error_t FailingMapper(size_t port_index, uart_device_t *uart_device)
+uart_error_t FailingMapper(size_t port_index, uart_device_t *uart_device,
+                           uart_device_info_t *device_info)
 {
     (void)port_index;
     (void)uart_device;
+    (void)device_info;
     return UART_ERROR_DEVICE_NOT_FOUND;
 }
 
-uart_error_t NoRegistersMapper(size_t port_index, uart_device_t *uart_device)
+uart_error_t NoRegistersMapper(size_t port_index, uart_device_t *uart_device,
+                               uart_device_info_t *device_info)
 {
-    if (uart_device == nullptr || port_index >= UART_DEVICE_COUNT)
+    if (uart_device == nullptr || device_info == nullptr ||
+        port_index >= UART_DEVICE_COUNT)
     {
         return UART_ERROR_INVALID_ARG;
     }
@@ -60,12 +67,16 @@ void ResetByteFifo(uart_byte_fifo_t *fifo)
 
 void FillQueue(serial_queue_t *queue)
 {
-    ASSERT_EQ(serial_queue_init(queue), UART_ERROR_NONE);
-    for (size_t i = 0U; i < SERIAL_QUEUE_FIXED_SIZE_WORDS; ++i)
-    {
-        ASSERT_EQ(serial_queue_push(queue, static_cast<uint32_t>(i)),
-                  UART_ERROR_NONE);
-    }
+    static const uint8_t fill[SERIAL_QUEUE_FIXED_SIZE_BYTES] = {};
+    size_t pushed = 0U;
+
+    /* Restart the port's ring over its own storage, then fill it. */
+    ASSERT_EQ(serial_queue_init_bytes_ex(queue, queue->storage,
+                                         queue->capacity),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_push_bytes(queue, fill, sizeof(fill), &pushed),
+              UART_ERROR_NONE);
+    ASSERT_EQ(pushed, sizeof(fill));
 }
 
 void PushReadByte(size_t port_index, uint8_t value)
@@ -101,29 +112,29 @@ TEST(SerialDriverCoverageApiTest, ExerciseCoverageBranches)
     const serial_descriptor_t descriptor3 =
         serial_port_init(SERIAL_PORT_3, UART_PORT_MODE_SERIAL);
     ASSERT_NE(descriptor3, SERIAL_DESCRIPTOR_INVALID);
-    FillQueue(&uart_devices[SERIAL_PORT_3].tx_queue);
+    FillQueue(uart_devices[SERIAL_PORT_3].tx_queue);
 
     const std::array<uint8_t, 5> five_bytes{{1U, 2U, 3U, 4U, 5U}};
     size_t bytes_written = 0U;
     EXPECT_EQ(serial_driver_write(descriptor3, five_bytes.data(),
                                   five_bytes.size(), &bytes_written),
               SERIAL_DRIVER_ERROR_TX_FULL);
-    EXPECT_EQ(bytes_written, 4U);
+    EXPECT_EQ(bytes_written, 0U);
 
     const serial_descriptor_t descriptor4 =
         serial_port_init(SERIAL_PORT_4, UART_PORT_MODE_SERIAL);
     ASSERT_NE(descriptor4, SERIAL_DESCRIPTOR_INVALID);
-    FillQueue(&uart_devices[SERIAL_PORT_4].tx_queue);
+    FillQueue(uart_devices[SERIAL_PORT_4].tx_queue);
     const std::array<uint8_t, 4> four_bytes{{9U, 8U, 7U, 6U}};
     EXPECT_EQ(serial_driver_write(descriptor4, four_bytes.data(),
                                   four_bytes.size(), &bytes_written),
-              SERIAL_DRIVER_OK);
-    EXPECT_EQ(bytes_written, four_bytes.size());
+              SERIAL_DRIVER_ERROR_TX_FULL);
+    EXPECT_EQ(bytes_written, 0U);
 
     const serial_descriptor_t descriptor5 =
         serial_port_init(SERIAL_PORT_5, UART_PORT_MODE_SERIAL);
     ASSERT_NE(descriptor5, SERIAL_DESCRIPTOR_INVALID);
-    uart_devices[SERIAL_PORT_5].tx_queue.initialized = false;
+    uart_devices[SERIAL_PORT_5].tx_queue->initialized = false;
     EXPECT_EQ(serial_driver_write(descriptor5, five_bytes.data(),
                                   five_bytes.size(), &bytes_written),
               SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
@@ -139,7 +150,7 @@ TEST(SerialDriverCoverageApiTest, ExerciseCoverageBranches)
     const serial_descriptor_t descriptor7 =
         serial_port_init(SERIAL_PORT_7, UART_PORT_MODE_SERIAL);
     ASSERT_NE(descriptor7, SERIAL_DESCRIPTOR_INVALID);
-    uart_devices[SERIAL_PORT_7].tx_queue.initialized = false;
+    uart_devices[SERIAL_PORT_7].tx_queue->initialized = false;
     EXPECT_EQ(serial_driver_write(descriptor7, four_bytes.data(),
                                   four_bytes.size(), &bytes_written),
               SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
@@ -158,11 +169,11 @@ TEST(SerialDriverCoverageApiTest, ExerciseCoverageBranches)
               SERIAL_DRIVER_ERROR_RX_EMPTY);
     EXPECT_EQ(bytes_read, 0U);
 
-    uart_devices[SERIAL_PORT_6].rx_queue.initialized = false;
+    uart_devices[SERIAL_PORT_6].rx_queue->initialized = false;
     EXPECT_EQ(serial_driver_read(descriptor6, &out_byte, 1U, &bytes_read),
               SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
 
-    uart_devices[SERIAL_PORT_6].tx_queue.initialized = false;
+    uart_devices[SERIAL_PORT_6].tx_queue->initialized = false;
     size_t tx_bytes = 0U;
     size_t rx_bytes = 0U;
     EXPECT_EQ(serial_driver_poll(descriptor6, 1U, 1U, &tx_bytes, &rx_bytes),
@@ -197,33 +208,43 @@ TEST(SerialDriverCoverageApiTest, ExerciseCoverageBranches)
     EXPECT_EQ(serial_driver_hw_set_mapper(nullptr), UART_ERROR_INVALID_ARG);
 
     uart_device_t device = {};
-    EXPECT_EQ(serial_driver_hw_map_uart(UART_DEVICE_COUNT, &device),
+    uart_device_info_t info = {};
+    EXPECT_EQ(serial_driver_hw_map_uart(UART_DEVICE_COUNT, &device, &info),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_hw_map_uart(0U, nullptr, &info),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_hw_map_uart(0U, &device, nullptr),
               UART_ERROR_INVALID_ARG);
-    EXPECT_EQ(serial_driver_hw_map_uart(0U, nullptr), UART_ERROR_INVALID_ARG);
 
     uart_device_t base_mapped = {};
-    base_mapped.uart_base_address =
+    uart_device_info_t base_info = {};
+    base_info.uart_base_address =
         reinterpret_cast<uintptr_t>(&g_registers[SERIAL_PORT_0]);
-    EXPECT_EQ(serial_driver_hw_map_uart(SERIAL_PORT_0, &base_mapped),
-              UART_ERROR_NONE);
+    EXPECT_EQ(
+        serial_driver_hw_map_uart(SERIAL_PORT_0, &base_mapped, &base_info),
+        UART_ERROR_NONE);
     EXPECT_EQ(base_mapped.registers, &g_registers[SERIAL_PORT_0]);
-    EXPECT_STREQ(base_mapped.device_name, "uart0");
+    EXPECT_STREQ(base_info.device_name, "uart0");
 
     uart_device_t default_mapped = {};
-    EXPECT_EQ(serial_driver_hw_map_uart(SERIAL_PORT_1, &default_mapped),
+    uart_device_info_t default_info = {};
+    EXPECT_EQ(serial_driver_hw_map_uart(SERIAL_PORT_1, &default_mapped,
+                                        &default_info),
               UART_ERROR_NONE);
     ASSERT_NE(default_mapped.registers, nullptr);
-    EXPECT_EQ(default_mapped.uart_base_address,
+    EXPECT_EQ(default_info.uart_base_address,
               reinterpret_cast<uintptr_t>(default_mapped.registers));
-    EXPECT_STREQ(default_mapped.device_name, "uart1");
+    EXPECT_STREQ(default_info.device_name, "uart1");
 
     uart_device_t already_mapped = {};
+    uart_device_info_t already_info = {};
     already_mapped.registers = &g_registers[SERIAL_PORT_0];
-    already_mapped.uart_base_address =
+    already_info.uart_base_address =
         reinterpret_cast<uintptr_t>(&g_registers[SERIAL_PORT_0]);
-    already_mapped.device_name = "already-set";
-    EXPECT_EQ(serial_driver_hw_map_uart(SERIAL_PORT_0, &already_mapped),
+    already_info.device_name = "already-set";
+    EXPECT_EQ(serial_driver_hw_map_uart(SERIAL_PORT_0, &already_mapped,
+                                        &already_info),
               UART_ERROR_NONE);
     EXPECT_EQ(already_mapped.registers, &g_registers[SERIAL_PORT_0]);
-    EXPECT_STREQ(already_mapped.device_name, "already-set");
+    EXPECT_STREQ(already_info.device_name, "already-set");
 }
@@ -1,4 +1,5 @@
 #include <cstdint>
+#include <cstring>
 
 extern "C"
 {
@@ -18,9 +19,6 @@ TEST(SerialDriverInternalHelpersTest, ExerciseGuardAndErrorBranches)
     EXPECT_EQ(serial_driver_get_entry(1U), nullptr);
 
     serial_driver_byte_fifo_reset(nullptr);
-    serial_driver_byte_fifo_push(nullptr, 0x55U);
-    EXPECT_EQ(serial_driver_byte_fifo_pop(nullptr), 0U);
-    EXPECT_FALSE(serial_driver_byte_fifo_is_full(nullptr));
     uart_byte_fifo_t local_fifo = {};
     local_fifo.count = 1U;
     EXPECT_FALSE(serial_driver_byte_fifo_is_empty(&local_fifo));
@@ -41,13 +39,26 @@ TEST(SerialDriverInternalHelpersTest, ExerciseGuardAndErrorBranches)
     test_device.registers = nullptr;
     EXPECT_EQ(serial_driver_get_mode_entry(1U, UART_PORT_MODE_SERIAL, &entry),
               SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+}
 
-    ASSERT_EQ(serial_queue_init(&test_device.tx_queue), UART_ERROR_NONE);
+TEST(SerialDriverInternalHelpersTest, TransmitMovesQueuedBytesIntoWriteFifo)
+{
+    uart_device_t test_device = {};
+    serial_queue_t tx_queue = {};
+    serial_queue_buffer_t tx_buffer = {};
     serial_descriptor_entry_t tx_entry = {};
+    const uint8_t payload[3] = {0x99U, 0xABU, 0xCDU};
+    uint8_t drained[2] = {0U, 0U};
+    size_t pushed = 0U;
+    size_t tx_bytes = 0U;
+
+    ASSERT_EQ(serial_driver_common_init(), SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_queue_init_bytes(&tx_queue, &tx_buffer),
+              UART_ERROR_NONE);
+    test_device.tx_queue = &tx_queue;
     tx_entry.uart_device = &test_device;
     tx_entry.port_index = 0U;
 
-    size_t tx_bytes = 0U;
     EXPECT_EQ(serial_driver_transmit_to_device_fifo(&tx_entry, 1U, nullptr),
               SERIAL_DRIVER_ERROR_INVALID_ARG);
 
@@ -55,130 +66,251 @@ TEST(SerialDriverInternalHelpersTest, ExerciseGuardAndErrorBranches)
               SERIAL_DRIVER_OK);
     EXPECT_EQ(tx_bytes, 0U);
 
-    tx_entry.staged_word = 0x99U;
-    tx_entry.staged_word_bytes = 1U;
-    EXPECT_EQ(serial_driver_transmit_to_device_fifo(&tx_entry, 1U, &tx_bytes),
+    ASSERT_EQ(serial_queue_push_bytes(&tx_queue, payload,
+                                      sizeof(payload), &pushed),
+              UART_ERROR_NONE);
+    EXPECT_EQ(serial_driver_transmit_to_device_fifo(&tx_entry, 0U, &tx_bytes),
               SERIAL_DRIVER_OK);
-    EXPECT_EQ(tx_bytes, 1U);
-    EXPECT_FALSE(serial_driver_byte_fifo_is_empty(&uart_fifo_map.write_fifos[0]));
+    EXPECT_EQ(tx_bytes, 0U);
 
-    serial_driver_byte_fifo_reset(&uart_fifo_map.write_fifos[0]);
-    tx_entry.staged_word = 0U;
-    tx_entry.staged_word_bytes = 0U;
-    tx_entry.tx_input_staged_word = 0xABU;
-    tx_entry.tx_input_staged_word_bytes = 1U;
-    EXPECT_EQ(serial_driver_transmit_to_device_fifo(&tx_entry, 1U, &tx_bytes),
+    EXPECT_EQ(serial_driver_transmit_to_device_fifo(&tx_entry, 2U, &tx_bytes),
               SERIAL_DRIVER_OK);
-    EXPECT_EQ(tx_bytes, 1U);
+    EXPECT_EQ(tx_bytes, 2U);
+    EXPECT_EQ(uart_fifo_map.write_fifos[0].count, 2U);
+    serial_driver_byte_fifo_read(&uart_fifo_map.write_fifos[0], drained, 2U);
+    EXPECT_EQ(drained[0], 0x99U);
+    EXPECT_EQ(drained[1], 0xABU);
 
-    serial_driver_byte_fifo_reset(&uart_fifo_map.write_fifos[0]);
     uart_fifo_map.write_fifos[0].count = UART_DEVICE_FIFO_SIZE_BYTES;
     EXPECT_EQ(serial_driver_transmit_to_device_fifo(&tx_entry, 1U, &tx_bytes),
               SERIAL_DRIVER_OK);
     EXPECT_EQ(tx_bytes, 0U);
-    uart_fifo_map.write_fifos[0].count = 0U;
-
-    EXPECT_EQ(serial_driver_transmit_to_device_fifo(&tx_entry, 0U, &tx_bytes),
-              SERIAL_DRIVER_OK);
-    EXPECT_EQ(tx_bytes, 0U);
-
     serial_driver_byte_fifo_reset(&uart_fifo_map.write_fifos[0]);
-    ASSERT_EQ(serial_queue_init(&test_device.tx_queue), UART_ERROR_NONE);
-    ASSERT_EQ(serial_queue_push(&test_device.tx_queue, 0x01020304U),
-              UART_ERROR_NONE);
-    tx_entry.staged_word = 0U;
-    tx_entry.staged_word_bytes = 0U;
-    tx_entry.tx_input_staged_word = 0xCDU;
-    tx_entry.tx_input_staged_word_bytes = 1U;
-    EXPECT_EQ(serial_driver_transmit_to_device_fifo(&tx_entry, 1U, &tx_bytes),
+
+    EXPECT_EQ(serial_driver_transmit_to_device_fifo(&tx_entry, 8U, &tx_bytes),
               SERIAL_DRIVER_OK);
     EXPECT_EQ(tx_bytes, 1U);
+    serial_driver_byte_fifo_read(&uart_fifo_map.write_fifos[0], drained, 1U);
+    EXPECT_EQ(drained[0], 0xCDU);
 
-    test_device.tx_queue.initialized = false;
-    tx_entry.staged_word = 0U;
-    tx_entry.staged_word_bytes = 0U;
-    tx_entry.tx_input_staged_word = 0U;
-    tx_entry.tx_input_staged_word_bytes = 0U;
+    tx_queue.initialized = false;
     EXPECT_EQ(serial_driver_transmit_to_device_fifo(&tx_entry, 1U, &tx_bytes),
               SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+}
 
+TEST(SerialDriverInternalHelpersTest, ReceiveStopsWhenQueueFullOrInvalid)
+{
+    static const uint8_t fill[SERIAL_QUEUE_FIXED_SIZE_BYTES] = {};
     uart_device_t rx_device = {};
-    ASSERT_EQ(serial_queue_init(&rx_device.rx_queue), UART_ERROR_NONE);
+    serial_queue_t rx_queue = {};
+    serial_queue_buffer_t rx_buffer = {};
     serial_descriptor_entry_t rx_entry = {};
+    uint8_t byte = 0U;
+    size_t moved = 0U;
+    size_t rx_bytes = 0U;
+
+    ASSERT_EQ(serial_driver_common_init(), SERIAL_DRIVER_OK);
     rx_entry.uart_device = &rx_device;
     rx_entry.port_index = 0U;
-    rx_entry.rx_staged_word = 0xAABBCCDDU;
-    rx_entry.rx_staged_word_bytes = sizeof(uint32_t);
 
-    for (size_t i = 0U; i < SERIAL_QUEUE_FIXED_SIZE_WORDS; ++i)
-    {
-        ASSERT_EQ(serial_queue_push(&rx_device.rx_queue, static_cast<uint32_t>(i)),
-                  UART_ERROR_NONE);
-    }
-
-    bool queue_full = false;
-    EXPECT_EQ(serial_driver_flush_rx_staged_word(&rx_entry, &queue_full),
-              SERIAL_DRIVER_OK);
-    EXPECT_TRUE(queue_full);
-
-    rx_device.rx_queue.initialized = false;
-    EXPECT_EQ(serial_driver_flush_rx_staged_word(&rx_entry, &queue_full),
-              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
-
-    size_t rx_bytes = 0U;
     EXPECT_EQ(serial_driver_receive_from_device_fifo(&rx_entry, 1U, nullptr),
               SERIAL_DRIVER_ERROR_INVALID_ARG);
-
-    rx_entry.rx_staged_word = 0x11223344U;
-    rx_entry.rx_staged_word_bytes = sizeof(uint32_t);
     EXPECT_EQ(serial_driver_receive_from_device_fifo(&rx_entry, 1U, &rx_bytes),
               SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
-    EXPECT_EQ(rx_bytes, 0U);
 
-    ASSERT_EQ(serial_queue_init(&rx_device.rx_queue), UART_ERROR_NONE);
-    for (size_t i = 0U; i < SERIAL_QUEUE_FIXED_SIZE_WORDS; ++i)
-    {
-        ASSERT_EQ(serial_queue_push(&rx_device.rx_queue, static_cast<uint32_t>(i)),
-                  UART_ERROR_NONE);
-    }
-    rx_entry.rx_staged_word = 0x01020304U;
-    rx_entry.rx_staged_word_bytes = sizeof(uint32_t);
+    rx_device.rx_queue = &rx_queue;
     EXPECT_EQ(serial_driver_receive_from_device_fifo(&rx_entry, 1U, &rx_bytes),
-              SERIAL_DRIVER_OK);
-    EXPECT_EQ(rx_bytes, 0U);
-
-    ASSERT_EQ(serial_queue_init(&rx_device.rx_queue), UART_ERROR_NONE);
-    serial_driver_byte_fifo_reset(&uart_fifo_map.read_fifos[0]);
-    rx_entry.rx_staged_word = 0U;
-    rx_entry.rx_staged_word_bytes = 0U;
+              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
+    ASSERT_EQ(serial_queue_init_bytes(&rx_queue, &rx_buffer),
+              UART_ERROR_NONE);
     EXPECT_EQ(serial_driver_receive_from_device_fifo(&rx_entry, 1U, &rx_bytes),
               SERIAL_DRIVER_OK);
     EXPECT_EQ(rx_bytes, 0U);
 
-    ASSERT_EQ(serial_queue_init(&rx_device.rx_queue), UART_ERROR_NONE);
-    serial_driver_byte_fifo_reset(&uart_fifo_map.read_fifos[0]);
-    serial_driver_byte_fifo_push(&uart_fifo_map.read_fifos[0], 0x10U);
-    rx_entry.rx_staged_word = 0U;
-    rx_entry.rx_staged_word_bytes = 0U;
+    const uint8_t arrived[2] = {0x10U, 0x20U};
+    serial_driver_byte_fifo_write(&uart_fifo_map.read_fifos[0], arrived, 2U);
     EXPECT_EQ(serial_driver_receive_from_device_fifo(&rx_entry, 1U, &rx_bytes),
               SERIAL_DRIVER_OK);
     EXPECT_EQ(rx_bytes, 1U);
+    ASSERT_EQ(serial_queue_pop_bytes(&rx_queue, &byte, 1U, &moved),
+              UART_ERROR_NONE);
+    EXPECT_EQ(byte, 0x10U);
 
-    rx_device.rx_queue.initialized = false;
+    ASSERT_EQ(serial_queue_push_bytes(&rx_queue, fill, sizeof(fill),
+                                      &moved),
+              UART_ERROR_NONE);
+    EXPECT_EQ(serial_driver_receive_from_device_fifo(&rx_entry, 4U, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(rx_bytes, 0U);
+    EXPECT_EQ(uart_fifo_map.read_fifos[0].count, 1U);
     serial_driver_byte_fifo_reset(&uart_fifo_map.read_fifos[0]);
-    serial_driver_byte_fifo_push(&uart_fifo_map.read_fifos[0], 0x42U);
-    rx_entry.rx_staged_word = 0U;
-    rx_entry.rx_staged_word_bytes = sizeof(uint32_t) - 1U;
-    EXPECT_EQ(serial_driver_receive_from_device_fifo(&rx_entry, 1U, &rx_bytes),
-              SERIAL_DRIVER_ERROR_NOT_INITIALIZED);
-    EXPECT_EQ(rx_bytes, 1U);
+}
 
-    ASSERT_EQ(serial_queue_init(&rx_device.rx_queue), UART_ERROR_NONE);
-    serial_driver_byte_fifo_reset(&uart_fifo_map.read_fifos[0]);
-    serial_driver_byte_fifo_push(&uart_fifo_map.read_fifos[0], 0x24U);
-    rx_entry.rx_staged_word = 0U;
-    rx_entry.rx_staged_word_bytes = sizeof(uint32_t) - 1U;
-    EXPECT_EQ(serial_driver_receive_from_device_fifo(&rx_entry, 1U, &rx_bytes),
+TEST(SerialDriverInternalHelpersTest, BindQueuesClaimsPoolPairsInOrder)
+{
+    static uint8_t tx_storage[256];
+    uart_device_t device = {};
+    serial_port_config_t config = {};
+
+    ASSERT_EQ(serial_driver_common_init(), SERIAL_DRIVER_OK);
+    config.mode = UART_PORT_MODE_SERIAL;
+
+    config.tx_capacity = SERIAL_QUEUE_FIXED_SIZE_BYTES + 1U;
+    EXPECT_EQ(serial_driver_bind_queues(&device, &config),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+    EXPECT_EQ(device.tx_queue, nullptr);
+    EXPECT_EQ(serial_queue_pool_used, 0U);
+
+    config.tx_capacity = 0U;
+    ASSERT_EQ(serial_driver_bind_queues(&device, &config), SERIAL_DRIVER_OK);
+    EXPECT_EQ(device.tx_queue, &uart_queue_pool[0].tx_queue);
+    EXPECT_EQ(device.rx_queue, &uart_queue_pool[0].rx_queue);
+    EXPECT_EQ(device.tx_queue->storage, &uart_queue_arena[0]);
+    EXPECT_EQ(device.rx_queue->storage,
+              &uart_queue_arena[UART_QUEUE_ARENA_RING_BYTES]);
+    EXPECT_EQ(serial_queue_arena_used, 2U * UART_QUEUE_ARENA_RING_BYTES);
+
+    /* Caller storage takes no arena bytes; small rings round to a line. */
+    config.tx_storage = tx_storage;
+    config.tx_capacity = sizeof(tx_storage);
+    config.rx_capacity = 100U;
+    ASSERT_EQ(serial_driver_bind_queues(&device, &config), SERIAL_DRIVER_OK);
+    EXPECT_EQ(device.tx_queue->storage, tx_storage);
+    EXPECT_EQ(serial_queue_arena_used,
+              2U * UART_QUEUE_ARENA_RING_BYTES +
+                  2U * SERIAL_QUEUE_CACHE_LINE_BYTES);
+
+    /* An exhausted arena fails without claiming a pair. */
+    serial_queue_arena_used = UART_QUEUE_ARENA_BYTES;
+    EXPECT_EQ(serial_driver_bind_queues(&device, &config),
+              SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+    EXPECT_EQ(serial_queue_pool_used, 2U);
+
+    serial_queue_pool_used = UART_SERIAL_QUEUE_POOL_SIZE;
+    EXPECT_EQ(serial_driver_bind_queues(&device, &config),
+              SERIAL_DRIVER_ERROR_NOT_CONFIGURED);
+
+    ASSERT_EQ(serial_driver_common_init(), SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_queue_pool_used, 0U);
+    EXPECT_EQ(serial_queue_arena_used, 0U);
+}
+
+TEST(SerialDriverInternalHelpersTest, XonXoffStripCompactsAcrossWrapSegments)
+{
+    uint8_t head[3] = {'a', UART_XOFF_CHAR, 'b'};
+    uint8_t tail[3] = {UART_XON_CHAR, 'c', UART_XOFF_CHAR};
+    uint8_t status[6] = {0U, 1U, 2U, 3U, 4U, 5U};
+    const serial_span_t first = {head, sizeof(head)};
+    const serial_span_t second = {tail, sizeof(tail)};
+    serial_descriptor_entry_t entry = {};
+
+    entry.xon_char = UART_XON_CHAR;
+    entry.xoff_char = UART_XOFF_CHAR;
+    EXPECT_EQ(serial_driver_flow_strip_rx(&entry, first, second, status, 6U),
+              6U);
+    EXPECT_FALSE(entry.tx_xoff_held);
+
+    entry.flow_control = SERIAL_FLOW_CONTROL_SW_XON_XOFF;
+    ASSERT_EQ(serial_driver_flow_strip_rx(&entry, first, second, status, 6U),
+              3U);
+    EXPECT_EQ(head[0], 'a');
+    EXPECT_EQ(head[1], 'b');
+    EXPECT_EQ(head[2], 'c');
+    EXPECT_EQ(status[1], 2U);
+    EXPECT_EQ(status[2], 4U);
+    EXPECT_TRUE(entry.tx_xoff_held);
+}
+
+TEST(SerialDriverInternalHelpersTest, PerPortStateOwnsWholeCacheLines)
+{
+    constexpr size_t kLine = SERIAL_QUEUE_CACHE_LINE_BYTES;
+
+    EXPECT_EQ(alignof(serial_descriptor_entry_t), kLine);
+    EXPECT_EQ(sizeof(serial_descriptor_entry_t) % kLine, 0U);
+    /* Read-only once open: dense, but the table starts on a line. */
+    EXPECT_EQ(kLine % sizeof(uart_device_t), 0U);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&uart_devices[0]) % kLine, 0U);
+    EXPECT_EQ(alignof(uart_byte_fifo_t), kLine);
+    EXPECT_EQ(sizeof(uart_byte_fifo_t) % kLine, 0U);
+    EXPECT_GE(offsetof(serial_queue_t, tail) - offsetof(serial_queue_t, head),
+              kLine);
+}
+
+TEST(SerialDriverInternalHelpersTest, BulkTransfersCopyAcrossWrapSegments)
+{
+    static uint8_t scratch[SERIAL_QUEUE_FIXED_SIZE_BYTES];
+    uart_device_t device = {};
+    serial_queue_t tx_queue = {};
+    serial_queue_t rx_queue = {};
+    serial_queue_buffer_t tx_buffer = {};
+    serial_queue_buffer_t rx_buffer = {};
+    serial_descriptor_entry_t entry = {};
+    uint8_t payload[300] = {};
+    uint8_t received[300] = {};
+    size_t moved = 0U;
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+
+    for (size_t i = 0U; i < sizeof(payload); ++i)
+    {
+        payload[i] = static_cast<uint8_t>(i * 3U + 1U);
+    }
+
+    ASSERT_EQ(serial_driver_common_init(), SERIAL_DRIVER_OK);
+    ASSERT_EQ(serial_queue_init_bytes(&tx_queue, &tx_buffer),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_init_bytes(&rx_queue, &rx_buffer),
+              UART_ERROR_NONE);
+    device.tx_queue = &tx_queue;
+    device.rx_queue = &rx_queue;
+    entry.uart_device = &device;
+    entry.port_index = 1U;
+
+    /* Park both queues and both FIFOs near their wrap points. */
+    ASSERT_EQ(serial_queue_push_bytes(&tx_queue, scratch, 1100U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_pop_bytes(&tx_queue, scratch, 1100U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_push_bytes(&rx_queue, scratch, 1150U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_pop_bytes(&rx_queue, scratch, 1150U, &moved),
+              UART_ERROR_NONE);
+    uart_byte_fifo_t *write_fifo = &uart_fifo_map.write_fifos[1];
+    uart_byte_fifo_t *read_fifo = &uart_fifo_map.read_fifos[1];
+    write_fifo->head = write_fifo->tail = 200U;
+    read_fifo->head = read_fifo->tail = 220U;
+
+    ASSERT_EQ(serial_queue_push_bytes(&tx_queue, payload, sizeof(payload),
+                                      &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_driver_transmit_to_device_fifo(&entry, sizeof(payload),
+                                                    &tx_bytes),
               SERIAL_DRIVER_OK);
-    EXPECT_EQ(rx_bytes, 1U);
+    EXPECT_EQ(tx_bytes, UART_DEVICE_FIFO_SIZE_BYTES);
+    EXPECT_EQ(write_fifo->count, UART_DEVICE_FIFO_SIZE_BYTES);
+    EXPECT_EQ(serial_queue_size(&tx_queue),
+              sizeof(payload) - UART_DEVICE_FIFO_SIZE_BYTES);
+
+    /* Loop the write FIFO into the read FIFO, then receive it. */
+    uint8_t wire[UART_DEVICE_FIFO_SIZE_BYTES] = {};
+    serial_driver_byte_fifo_read(write_fifo, wire, tx_bytes);
+    serial_driver_byte_fifo_write(read_fifo, wire, tx_bytes);
+    ASSERT_EQ(serial_driver_receive_from_device_fifo(&entry, 1000U, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(rx_bytes, UART_DEVICE_FIFO_SIZE_BYTES);
+    EXPECT_EQ(read_fifo->count, 0U);
+
+    ASSERT_EQ(serial_driver_transmit_to_device_fifo(&entry, 1000U, &tx_bytes),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(tx_bytes, sizeof(payload) - UART_DEVICE_FIFO_SIZE_BYTES);
+    serial_driver_byte_fifo_read(write_fifo, wire, tx_bytes);
+    serial_driver_byte_fifo_write(read_fifo, wire, tx_bytes);
+    ASSERT_EQ(serial_driver_receive_from_device_fifo(&entry, 1000U, &rx_bytes),
+              SERIAL_DRIVER_OK);
+
+    ASSERT_EQ(serial_queue_pop_bytes(&rx_queue, received, sizeof(received),
+                                     &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(moved, sizeof(received));
+    EXPECT_EQ(std::memcmp(received, payload, sizeof(payload)), 0);
 }
@@ -0,0 +1,147 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+extern "C"
+{
+#include "device_driver/device_driver.h"
+#include "device_driver/hw_abstraction.h"
+
+    /* Test-only hook defined in device_driver.c. */
+    serial_driver_error_t serial_driver_reset(void);
+    uart_error_t serial_driver_hw_map_uart(size_t port_index,
+                                           uart_device_t *uart_device,
+                                           uart_device_info_t *device_info);
+}
+
+#include <gtest/gtest.h>
+
+/* Built against a two-card (16-port) driver. */
+static_assert(UART_DEVICE_COUNT == 2U * XR17V358_UART_CHANNEL_COUNT,
+              "multi-card tests need two cards of device slots");
+
+namespace
+{
+
+std::array<xr17c358_channel_register_map_t, UART_DEVICE_COUNT>
+    g_card_registers{};
+
+uart_error_t CardMapper(size_t port_index, uart_device_t *uart_device,
+                        uart_device_info_t *device_info)
+{
+    if (uart_device == nullptr || device_info == nullptr ||
+        port_index >= UART_DEVICE_COUNT)
+    {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    std::memset(&g_card_registers[port_index], 0,
+                sizeof(g_card_registers[port_index]));
+    uart_device->registers = &g_card_registers[port_index];
+    device_info->uart_base_address =
+        reinterpret_cast<uintptr_t>(&g_card_registers[port_index]);
+    device_info->device_name = "card-uart";
+    return UART_ERROR_NONE;
+}
+
+void PushBytes(size_t port_index, size_t count)
+{
+    uart_byte_fifo_t *fifo = &uart_fifo_map.read_fifos[port_index];
+
+    for (size_t i = 0U; i < count; ++i)
+    {
+        const uint8_t value = static_cast<uint8_t>(i);
+
+        serial_driver_byte_fifo_write(fifo, &value, 1U);
+    }
+}
+
+void RaiseRxTimeout(xr17v358_device_config_registers_t *device_config,
+                    size_t channel)
+{
+    const uint32_t sources = XR17V358_INT_SOURCE_RX_TIMEOUT
+                             << (channel * XR17V358_INT_SOURCE_BITS);
+
+    device_config->generic.int0 =
+        static_cast<uint8_t>(XR17V358_INT0_CHANNEL_BIT(channel));
+    device_config->generic.int1 = static_cast<uint8_t>(sources);
+    device_config->generic.int2 = static_cast<uint8_t>(sources >> 8U);
+    device_config->generic.int3 = static_cast<uint8_t>(sources >> 16U);
+}
+
+} // namespace
+
+class SerialDriverMultiCardTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(serial_driver_hw_set_mapper(CardMapper), UART_ERROR_NONE);
+        ASSERT_EQ(serial_driver_reset(), SERIAL_DRIVER_OK);
+    }
+
+    void TearDown() override
+    {
+        EXPECT_EQ(serial_driver_reset(), SERIAL_DRIVER_OK);
+        serial_driver_hw_reset_mapper();
+    }
+};
+
+TEST_F(SerialDriverMultiCardTest, SecondCardChannelsDispatchToTheirOwnPorts)
+{
+    constexpr size_t kChannel = 2U;
+    constexpr serial_ports_t kCard0Port = SERIAL_PORT_2;
+    constexpr serial_ports_t kCard1Port = SERIAL_PORT_10;
+    static_assert(kCard1Port == XR17V358_UART_CHANNEL_COUNT + kChannel,
+                  "port 10 is channel 2 of the second card");
+    xr17v358_device_config_registers_t card1_config{};
+    std::array<serial_poll_result_t, UART_DEVICE_COUNT> results{};
+    size_t count = 0U;
+    uint32_t channels = 0U;
+
+    const serial_descriptor_t card0_port =
+        serial_port_init(kCard0Port, UART_PORT_MODE_SERIAL);
+    const serial_descriptor_t card1_port =
+        serial_port_init(kCard1Port, UART_PORT_MODE_SERIAL);
+    ASSERT_NE(card0_port, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_NE(card1_port, SERIAL_DESCRIPTOR_INVALID);
+    PushBytes(kCard0Port, 3U);
+    PushBytes(kCard1Port, 5U);
+
+    EXPECT_EQ(serial_port_init(SERIAL_PORT_COUNT, UART_PORT_MODE_SERIAL),
+              SERIAL_DESCRIPTOR_INVALID);
+    EXPECT_EQ(serial_driver_handle_interrupt(2U, &card1_config, &channels),
+              SERIAL_DRIVER_ERROR_INVALID_ARG);
+
+    /* Channel 2 of the second card is port 10, not port 2. */
+    RaiseRxTimeout(&card1_config, kChannel);
+    ASSERT_EQ(serial_driver_service_event(1U, &card1_config, results.data(),
+                                          results.size(), &count),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(count, 1U);
+    EXPECT_EQ(results[0].descriptor, card1_port);
+    EXPECT_EQ(results[0].rx_bytes, 5U);
+    EXPECT_EQ(uart_fifo_map.read_fifos[kCard0Port].count, 3U);
+
+    ASSERT_EQ(serial_driver_handle_interrupt(1U, &card1_config, &channels),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(channels, XR17V358_INT0_CHANNEL_BIT(kChannel));
+}
+
+TEST_F(SerialDriverMultiCardTest, DefaultMapperNamesEverySlot)
+{
+    serial_driver_hw_reset_mapper();
+
+    for (size_t port = 0U; port < UART_DEVICE_COUNT; ++port)
+    {
+        uart_device_t device = {};
+        uart_device_info_t info = {};
+
+        ASSERT_EQ(serial_driver_hw_map_uart(port, &device, &info),
+                  UART_ERROR_NONE);
+        ASSERT_NE(info.device_name, nullptr);
+        EXPECT_EQ(std::string(info.device_name),
+                  "uart" + std::to_string(port));
+    }
+}
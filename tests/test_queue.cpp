@@ -1,4 +1,5 @@
 #include <cstdint>
+#include <cstring>
 
 extern "C" {
 #include "device_driver/queue.h"
@@ -7,7 +8,12 @@ extern "C" {
 #include <gtest/gtest.h>
 
 TEST(SerialQueueTest, InitRejectsNull) {
-    EXPECT_EQ(serial_queue_init(nullptr), UART_ERROR_INVALID_ARG);
+    serial_queue_t queue = {};
+
+    EXPECT_EQ(serial_queue_init(nullptr, nullptr), UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_init(&queue, nullptr), UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_init_bytes(&queue, nullptr),
+              UART_ERROR_INVALID_ARG);
 }
 
 TEST(SerialQueueTest, InvalidAndUninitializedPathsAreReported) {
@@ -29,9 +35,10 @@ TEST(SerialQueueTest, InvalidAndUninitializedPathsAreReported) {
 
 TEST(SerialQueueTest, PushPopMaintainsOrder) {
     serial_queue_t queue = {};
+    serial_queue_buffer_t buffer = {};
     uint32_t value = 0U;
 
-    ASSERT_EQ(serial_queue_init(&queue), UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_init(&queue, &buffer), UART_ERROR_NONE);
     ASSERT_TRUE(serial_queue_is_empty(&queue));
 
     ASSERT_EQ(serial_queue_push(&queue, 0x11111111U), UART_ERROR_NONE);
@@ -54,9 +61,10 @@ TEST(SerialQueueTest, PushPopMaintainsOrder) {
 
 TEST(SerialQueueTest, FullAndEmptyStatesAreReported) {
     serial_queue_t queue = {};
+    serial_queue_buffer_t buffer = {};
     uint32_t value = 0U;
 
-    ASSERT_EQ(serial_queue_init(&queue), UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_init(&queue, &buffer), UART_ERROR_NONE);
 
     for (size_t i = 0U; i < SERIAL_QUEUE_FIXED_SIZE_WORDS; ++i) {
         ASSERT_EQ(serial_queue_push(&queue, static_cast<uint32_t>(i)),
@@ -76,9 +84,10 @@ TEST(SerialQueueTest, FullAndEmptyStatesAreReported) {
 
 TEST(SerialQueueTest, WrapAroundAfterPop) {
     serial_queue_t queue = {};
+    serial_queue_buffer_t buffer = {};
     uint32_t value = 0U;
 
-    ASSERT_EQ(serial_queue_init(&queue), UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_init(&queue, &buffer), UART_ERROR_NONE);
 
     for (size_t i = 0U; i < SERIAL_QUEUE_FIXED_SIZE_WORDS; ++i) {
         ASSERT_EQ(serial_queue_push(&queue, static_cast<uint32_t>(i)),
@@ -95,3 +104,444 @@ TEST(SerialQueueTest, WrapAroundAfterPop) {
 
     EXPECT_TRUE(serial_queue_is_full(&queue));
 }
+
+TEST(SerialQueueTest, BulkPushPopValidatesArguments) {
+    serial_queue_t queue = {};
+    serial_queue_buffer_t buffer = {};
+    uint32_t values[2] = {0U, 0U};
+    size_t moved = 7U;
+
+    EXPECT_EQ(serial_queue_push_n(&queue, values, 2U, nullptr),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_push_n(&queue, nullptr, 2U, &moved),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_push_n(&queue, values, 2U, &moved),
+              UART_ERROR_NOT_INITIALIZED);
+    EXPECT_EQ(moved, 0U);
+
+    EXPECT_EQ(serial_queue_pop_n(nullptr, values, 2U, &moved),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_pop_n(&queue, nullptr, 2U, &moved),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_pop_n(&queue, values, 2U, &moved),
+              UART_ERROR_NOT_INITIALIZED);
+
+    ASSERT_EQ(serial_queue_init(&queue, &buffer), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_push_n(&queue, nullptr, 0U, &moved),
+              UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_pop_n(&queue, values, 2U, &moved),
+              UART_ERROR_FIFO_QUEUE_EMPTY);
+    EXPECT_EQ(serial_queue_pop_n(&queue, nullptr, 0U, &moved),
+              UART_ERROR_NONE);
+}
+
+TEST(SerialQueueTest, BulkPushPopWrapsAndStopsAtCapacity) {
+    serial_queue_t queue = {};
+    serial_queue_buffer_t buffer = {};
+    uint32_t values[SERIAL_QUEUE_FIXED_SIZE_WORDS] = {};
+    uint32_t popped[SERIAL_QUEUE_FIXED_SIZE_WORDS] = {};
+    size_t moved = 0U;
+
+    for (size_t i = 0U; i < SERIAL_QUEUE_FIXED_SIZE_WORDS; ++i) {
+        values[i] = static_cast<uint32_t>(0x1000U + i);
+    }
+
+    ASSERT_EQ(serial_queue_init(&queue, &buffer), UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_push_n(&queue, values, 250U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(moved, 250U);
+    ASSERT_EQ(serial_queue_pop_n(&queue, popped, 200U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(moved, 200U);
+
+    /* 50 words queued at index 200; the next push wraps past the end. */
+    ASSERT_EQ(serial_queue_push_n(&queue, values, SERIAL_QUEUE_FIXED_SIZE_WORDS,
+                                  &moved),
+              UART_ERROR_NONE);
+    EXPECT_EQ(moved, SERIAL_QUEUE_FIXED_SIZE_WORDS - 50U);
+    EXPECT_TRUE(serial_queue_is_full(&queue));
+    EXPECT_EQ(serial_queue_push_n(&queue, values, 1U, &moved),
+              UART_ERROR_FIFO_QUEUE_FULL);
+    EXPECT_EQ(moved, 0U);
+
+    ASSERT_EQ(serial_queue_pop_n(&queue, popped, SERIAL_QUEUE_FIXED_SIZE_WORDS,
+                                 &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(moved, SERIAL_QUEUE_FIXED_SIZE_WORDS);
+    for (size_t i = 0U; i < 50U; ++i) {
+        EXPECT_EQ(popped[i], 0x1000U + 200U + i);
+    }
+    for (size_t i = 50U; i < SERIAL_QUEUE_FIXED_SIZE_WORDS; ++i) {
+        EXPECT_EQ(popped[i], 0x1000U + (i - 50U));
+    }
+    EXPECT_TRUE(serial_queue_is_empty(&queue));
+}
+
+TEST(SerialQueueTest, ByteQueueRoundTripsAcrossWrap) {
+    serial_queue_t queue = {};
+    serial_queue_buffer_t buffer = {};
+    uint8_t input[SERIAL_QUEUE_FIXED_SIZE_BYTES] = {};
+    uint8_t output[SERIAL_QUEUE_FIXED_SIZE_BYTES] = {};
+    size_t moved = 0U;
+
+    for (size_t i = 0U; i < sizeof(input); ++i) {
+        input[i] = static_cast<uint8_t>(i * 13U);
+    }
+
+    ASSERT_EQ(serial_queue_init_bytes(&queue, &buffer), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_space(&queue), SERIAL_QUEUE_FIXED_SIZE_BYTES);
+    ASSERT_EQ(serial_queue_push_bytes(&queue, input, 1000U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_pop_bytes(&queue, output, 999U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(moved, 999U);
+
+    ASSERT_EQ(serial_queue_push_bytes(&queue, input, sizeof(input), &moved),
+              UART_ERROR_NONE);
+    EXPECT_EQ(moved, sizeof(input) - 1U);
+    EXPECT_TRUE(serial_queue_is_full(&queue));
+    EXPECT_EQ(serial_queue_space(&queue), 0U);
+    EXPECT_EQ(serial_queue_push_bytes(&queue, input, 1U, &moved),
+              UART_ERROR_FIFO_QUEUE_FULL);
+
+    ASSERT_EQ(serial_queue_pop_bytes(&queue, output, sizeof(output), &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(moved, sizeof(output));
+    EXPECT_EQ(output[0], input[999]);
+    for (size_t i = 1U; i < sizeof(output); ++i) {
+        EXPECT_EQ(output[i], input[i - 1U]);
+    }
+    EXPECT_EQ(serial_queue_pop_bytes(&queue, output, 1U, &moved),
+              UART_ERROR_FIFO_QUEUE_EMPTY);
+}
+
+TEST(SerialQueueTest, WordAndByteApisRejectOtherMode) {
+    serial_queue_t queue = {};
+    serial_queue_buffer_t buffer = {};
+    uint32_t word = 0U;
+    uint8_t byte = 0U;
+    size_t moved = 0U;
+
+    ASSERT_EQ(serial_queue_init_bytes(&queue, &buffer), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_push(&queue, 1U), UART_ERROR_NOT_CONFIGURED);
+    EXPECT_EQ(serial_queue_pop(&queue, &word), UART_ERROR_NOT_CONFIGURED);
+    EXPECT_EQ(serial_queue_push_n(&queue, &word, 1U, &moved),
+              UART_ERROR_NOT_CONFIGURED);
+
+    ASSERT_EQ(serial_queue_init(&queue, &buffer), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_push_bytes(&queue, &byte, 1U, &moved),
+              UART_ERROR_NOT_CONFIGURED);
+    EXPECT_EQ(serial_queue_pop_bytes(&queue, &byte, 1U, &moved),
+              UART_ERROR_NOT_CONFIGURED);
+    EXPECT_EQ(serial_queue_space(nullptr), 0U);
+}
+
+TEST(SerialQueueTest, MultiProducerPushIsAllOrNothing) {
+    serial_queue_t queue = {};
+    serial_queue_buffer_t buffer = {};
+    uint8_t input[SERIAL_QUEUE_FIXED_SIZE_BYTES] = {};
+    uint8_t output[8] = {};
+    size_t moved = 0U;
+
+    EXPECT_EQ(serial_queue_push_bytes_mp(&queue, input, 1U),
+              UART_ERROR_NOT_INITIALIZED);
+    EXPECT_EQ(serial_queue_sync_producers(nullptr), UART_ERROR_NOT_INITIALIZED);
+    EXPECT_EQ(serial_queue_push_bytes_mp(&queue, nullptr, 1U),
+              UART_ERROR_INVALID_ARG);
+
+    ASSERT_EQ(serial_queue_init(&queue, &buffer), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_push_bytes_mp(&queue, input, 1U),
+              UART_ERROR_NOT_CONFIGURED);
+
+    ASSERT_EQ(serial_queue_init_bytes(&queue, &buffer), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_push_bytes_mp(&queue, input, 0U), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_push_bytes_mp(&queue, input, sizeof(input) + 1U),
+              UART_ERROR_INVALID_ARG);
+
+    /* Single-producer pushes first, then hand over to multi-producer mode. */
+    ASSERT_EQ(serial_queue_push_bytes(&queue, input, 1000U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_sync_producers(&queue), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_push_bytes_mp(&queue, input, 201U),
+              UART_ERROR_FIFO_QUEUE_FULL);
+    EXPECT_EQ(serial_queue_size(&queue), 1000U);
+
+    input[0] = 0x5AU;
+    input[199] = 0xA5U;
+    ASSERT_EQ(serial_queue_pop_bytes(&queue, output, 8U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_push_bytes_mp(&queue, input, 200U),
+              UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_size(&queue), 1192U);
+
+    uint8_t drained[SERIAL_QUEUE_FIXED_SIZE_BYTES] = {};
+    ASSERT_EQ(serial_queue_pop_bytes(&queue, drained, sizeof(drained), &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(moved, 1192U);
+    EXPECT_EQ(drained[992], 0x5AU);
+    EXPECT_EQ(drained[1191], 0xA5U);
+}
+
+TEST(SerialQueueTest, ReserveCommitSplitsAtWrapPoint) {
+    serial_queue_t queue = {};
+    serial_queue_buffer_t buffer = {};
+    serial_span_t first = {};
+    serial_span_t second = {};
+    uint8_t scratch[SERIAL_QUEUE_FIXED_SIZE_BYTES] = {};
+    size_t moved = 0U;
+
+    EXPECT_EQ(serial_queue_reserve_bytes(&queue, 0U, &first, &second),
+              UART_ERROR_NOT_INITIALIZED);
+    EXPECT_EQ(serial_queue_reserve_bytes(&queue, 0U, nullptr, &second),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_commit_bytes(nullptr, 0U),
+              UART_ERROR_NOT_INITIALIZED);
+
+    ASSERT_EQ(serial_queue_init(&queue, &buffer), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_reserve_bytes(&queue, 0U, &first, &second),
+              UART_ERROR_NOT_CONFIGURED);
+    EXPECT_EQ(serial_queue_commit_bytes(&queue, 0U), UART_ERROR_NOT_CONFIGURED);
+
+    ASSERT_EQ(serial_queue_init_bytes(&queue, &buffer), UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_reserve_bytes(&queue, 0U, &first, &second),
+              UART_ERROR_NONE);
+    EXPECT_EQ(first.length, SERIAL_QUEUE_FIXED_SIZE_BYTES);
+    EXPECT_EQ(second.length, 0U);
+    EXPECT_EQ(second.data, nullptr);
+
+    /* Move the ring 1000 bytes forward so free space wraps. */
+    ASSERT_EQ(serial_queue_commit_bytes(&queue, 1000U), UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_pop_bytes(&queue, scratch, 1000U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_push_bytes(&queue, scratch, 100U, &moved),
+              UART_ERROR_NONE);
+
+    ASSERT_EQ(serial_queue_reserve_bytes(&queue, 1100U, &first, &second),
+              UART_ERROR_NONE);
+    EXPECT_EQ(first.length, 100U);
+    EXPECT_EQ(second.length, 1000U);
+    EXPECT_EQ(second.data, &buffer.bytes[0]);
+    EXPECT_EQ(serial_queue_reserve_bytes(&queue, 1101U, &first, &second),
+              UART_ERROR_FIFO_QUEUE_FULL);
+    EXPECT_EQ(first.length, 0U);
+
+    ASSERT_EQ(serial_queue_reserve_bytes(&queue, 102U, &first, &second),
+              UART_ERROR_NONE);
+    std::memset(first.data, 0x11, first.length);
+    second.data[0] = 0x22U;
+    second.data[1] = 0x33U;
+    EXPECT_EQ(serial_queue_commit_bytes(&queue, 1101U), UART_ERROR_INVALID_ARG);
+    ASSERT_EQ(serial_queue_commit_bytes(&queue, 102U), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_size(&queue), 202U);
+
+    ASSERT_EQ(serial_queue_pop_bytes(&queue, scratch, 202U, &moved),
+              UART_ERROR_NONE);
+    EXPECT_EQ(scratch[100], 0x11U);
+    EXPECT_EQ(scratch[199], 0x11U);
+    EXPECT_EQ(scratch[200], 0x22U);
+    EXPECT_EQ(scratch[201], 0x33U);
+}
+
+TEST(SerialQueueTest, PeekConsumeSplitsAtWrapPoint) {
+    serial_queue_t queue = {};
+    serial_queue_buffer_t buffer = {};
+    serial_const_span_t first = {};
+    serial_const_span_t second = {};
+    uint8_t input[SERIAL_QUEUE_FIXED_SIZE_BYTES] = {};
+    size_t moved = 0U;
+
+    for (size_t i = 0U; i < sizeof(input); ++i) {
+        input[i] = static_cast<uint8_t>(i);
+    }
+
+    EXPECT_EQ(serial_queue_peek_bytes(&queue, &first, &second),
+              UART_ERROR_NOT_INITIALIZED);
+    EXPECT_EQ(serial_queue_peek_bytes(&queue, &first, nullptr),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_consume_bytes(nullptr, 0U),
+              UART_ERROR_NOT_INITIALIZED);
+
+    ASSERT_EQ(serial_queue_init(&queue, &buffer), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_peek_bytes(&queue, &first, &second),
+              UART_ERROR_NOT_CONFIGURED);
+    EXPECT_EQ(serial_queue_consume_bytes(&queue, 0U),
+              UART_ERROR_NOT_CONFIGURED);
+
+    ASSERT_EQ(serial_queue_init_bytes(&queue, &buffer), UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_peek_bytes(&queue, &first, &second),
+              UART_ERROR_FIFO_QUEUE_EMPTY);
+    EXPECT_EQ(serial_queue_consume_bytes(&queue, 1U), UART_ERROR_INVALID_ARG);
+
+    ASSERT_EQ(serial_queue_push_bytes(&queue, input, 1000U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_peek_bytes(&queue, &first, &second),
+              UART_ERROR_NONE);
+    EXPECT_EQ(first.length, 1000U);
+    EXPECT_EQ(second.length, 0U);
+    EXPECT_EQ(second.data, nullptr);
+    ASSERT_EQ(serial_queue_consume_bytes(&queue, 1000U), UART_ERROR_NONE);
+
+    ASSERT_EQ(serial_queue_push_bytes(&queue, input, 250U, &moved),
+              UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_peek_bytes(&queue, &first, &second),
+              UART_ERROR_NONE);
+    EXPECT_EQ(first.length, 200U);
+    EXPECT_EQ(second.length, 50U);
+    EXPECT_EQ(first.data[199], 199U);
+    EXPECT_EQ(second.data[0], 200U);
+
+    ASSERT_EQ(serial_queue_consume_bytes(&queue, 201U), UART_ERROR_NONE);
+    ASSERT_EQ(serial_queue_peek_bytes(&queue, &first, &second),
+              UART_ERROR_NONE);
+    EXPECT_EQ(first.length, 49U);
+    EXPECT_EQ(second.length, 0U);
+    EXPECT_EQ(first.data[0], 201U);
+    EXPECT_EQ(serial_queue_consume_bytes(&queue, 50U), UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_size(&queue), 49U);
+}
+
+TEST(SerialQueueTest, CallerStorageSupportsLargeAndPowerOfTwoRings) {
+    serial_queue_t queue = {};
+    static uint8_t arena[4096];
+    static uint8_t odd_arena[3000];
+    uint8_t input[1500] = {};
+    uint8_t output[1500] = {};
+    size_t moved = 0U;
+
+    EXPECT_EQ(serial_queue_init_bytes_ex(nullptr, arena, sizeof(arena)),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_init_bytes_ex(&queue, arena, 0U),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_init_bytes_ex(&queue, nullptr, 256U),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_queue_init_bytes_ex(&queue, arena,
+                                         SERIAL_QUEUE_MAX_CAPACITY_BYTES + 1U),
+              UART_ERROR_INVALID_ARG);
+
+    ASSERT_EQ(serial_queue_init_bytes_ex(&queue, arena, 256U),
+              UART_ERROR_NONE);
+    EXPECT_EQ(serial_queue_space(&queue), 256U);
+
+    /* Cycle both ring kinds far past 2 * capacity to cover index wrap. */
+    for (uint8_t *storage : {arena, odd_arena}) {
+        const size_t capacity =
+            (storage == arena) ? sizeof(arena) : sizeof(odd_arena);
+        uint8_t seed = 0U;
+
+        ASSERT_EQ(serial_queue_init_bytes_ex(&queue, storage, capacity),
+                  UART_ERROR_NONE);
+        EXPECT_EQ(serial_queue_space(&queue), capacity);
+        for (size_t round = 0U; round < 20U; ++round) {
+            for (size_t i = 0U; i < sizeof(input); ++i) {
+                input[i] = seed++;
+            }
+            ASSERT_EQ(serial_queue_push_bytes(&queue, input, sizeof(input),
+                                              &moved),
+                      UART_ERROR_NONE);
+            ASSERT_EQ(moved, sizeof(input));
+            ASSERT_EQ(serial_queue_pop_bytes(&queue, output, sizeof(output),
+                                             &moved),
+                      UART_ERROR_NONE);
+            ASSERT_EQ(moved, sizeof(output));
+            ASSERT_EQ(std::memcmp(input, output, sizeof(input)), 0);
+        }
+
+        for (size_t filled = 0U; filled < capacity; filled += moved) {
+            ASSERT_EQ(serial_queue_push_bytes(&queue, input, sizeof(input),
+                                              &moved),
+                      UART_ERROR_NONE);
+        }
+        EXPECT_TRUE(serial_queue_is_full(&queue));
+        EXPECT_EQ(serial_queue_size(&queue), capacity);
+        EXPECT_EQ(serial_queue_push_bytes(&queue, input, 1U, &moved),
+                  UART_ERROR_FIFO_QUEUE_FULL);
+    }
+}
+
+/*
+ * A multi-producer push loads reserve and tail, checks space, then CASes
+ * reserve. Stand in for a producer preempted between the load and the CAS
+ * while other producers push 2 * capacity bytes and the consumer drains
+ * only half: reserve has gone a full index cycle and the ring is full of
+ * unread bytes that the stale reservation must not overwrite.
+ */
+TEST(SerialQueueTest, StaleMultiProducerReservationFailsAfterFullWrap) {
+    serial_queue_t queue = {};
+    static uint8_t arena[16];
+    static uint8_t odd_arena[12];
+    uint8_t input[16] = {};
+    uint8_t output[16] = {};
+    size_t moved = 0U;
+
+    for (uint8_t *storage : {arena, odd_arena}) {
+        const size_t capacity =
+            (storage == arena) ? sizeof(arena) : sizeof(odd_arena);
+
+        ASSERT_EQ(serial_queue_init_bytes_ex(&queue, storage, capacity),
+                  UART_ERROR_NONE);
+        const uint64_t stale_start = queue.reserve;
+        const uint64_t stale_tail = queue.tail;
+        ASSERT_EQ(stale_start - stale_tail, 0U);
+
+        ASSERT_EQ(serial_queue_push_bytes_mp(&queue, input, capacity),
+                  UART_ERROR_NONE);
+        ASSERT_EQ(serial_queue_pop_bytes(&queue, output, capacity, &moved),
+                  UART_ERROR_NONE);
+        ASSERT_EQ(moved, capacity);
+        for (size_t i = 0U; i < capacity; ++i) {
+            input[i] = static_cast<uint8_t>(0xC0U + i);
+        }
+        ASSERT_EQ(serial_queue_push_bytes_mp(&queue, input, capacity),
+                  UART_ERROR_NONE);
+
+        /* The resumed producer's CAS must miss, and its retry sees no room. */
+        EXPECT_NE(queue.reserve, stale_start);
+        EXPECT_EQ(serial_queue_push_bytes_mp(&queue, output, 1U),
+                  UART_ERROR_FIFO_QUEUE_FULL);
+        ASSERT_EQ(serial_queue_pop_bytes(&queue, output, capacity, &moved),
+                  UART_ERROR_NONE);
+        ASSERT_EQ(moved, capacity);
+        EXPECT_EQ(std::memcmp(input, output, capacity), 0);
+    }
+}
+
+/*
+ * The indices are 64-bit on every target. Start a 12-byte ring just below
+ * 2^32, where a 32-bit counter would wrap and jump the modulo fold, and
+ * check that the storage offset keeps advancing by exactly one lap.
+ */
+TEST(SerialQueueTest, NonPowerOfTwoRingStaysContinuousAcross32BitWrap) {
+    serial_queue_t queue = {};
+    static uint8_t arena[12];
+    const uint64_t start = (uint64_t{1} << 32) - 5U;
+    uint8_t input[sizeof(arena)] = {};
+    uint8_t output[sizeof(arena)] = {};
+    serial_const_span_t first = {};
+    serial_const_span_t second = {};
+    size_t moved = 0U;
+
+    ASSERT_EQ(serial_queue_init_bytes_ex(&queue, arena, sizeof(arena)),
+              UART_ERROR_NONE);
+    queue.head = start;
+    queue.reserve = start;
+    queue.tail = start;
+
+    for (int lap = 0; lap < 3; ++lap) {
+        for (size_t i = 0U; i < sizeof(input); ++i) {
+            input[i] = static_cast<uint8_t>(lap * 0x20 + i);
+        }
+        ASSERT_EQ(serial_queue_push_bytes(&queue, input, sizeof(input),
+                                          &moved),
+                  UART_ERROR_NONE);
+        ASSERT_EQ(moved, sizeof(input));
+        ASSERT_EQ(serial_queue_peek_bytes(&queue, &first, &second),
+                  UART_ERROR_NONE);
+        EXPECT_EQ(first.data, &arena[start % sizeof(arena)]);
+        ASSERT_EQ(serial_queue_pop_bytes(&queue, output, sizeof(output),
+                                         &moved),
+                  UART_ERROR_NONE);
+        ASSERT_EQ(moved, sizeof(output));
+        EXPECT_EQ(std::memcmp(input, output, sizeof(input)), 0);
+    }
+    EXPECT_GT(queue.tail, uint64_t{1} << 32);
+}
@@ -0,0 +1,351 @@
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include "device_driver/device_driver.h"
+#include "device_driver/hw_abstraction.h"
+#include "device_driver/queue.h"
+
+    /* Test-only hook defined in device_driver.c. */
+    serial_driver_error_t serial_driver_reset(void);
+}
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+constexpr size_t kStressBytes = 512U * 1024U;
+
+uint8_t PatternByte(size_t index)
+{
+    return static_cast<uint8_t>((index * 31U) ^ (index >> 8U));
+}
+
+std::array<xr17c358_channel_register_map_t, UART_DEVICE_COUNT>
+    g_stress_registers{};
+
+uart_error_t StressMapper(size_t port_index, uart_device_t *uart_device,
+                          uart_device_info_t *device_info)
+{
+    if (uart_device == nullptr || device_info == nullptr ||
+        port_index >= UART_DEVICE_COUNT)
+    {
+        return UART_ERROR_INVALID_ARG;
+    }
+
+    std::memset(&g_stress_registers[port_index], 0,
+                sizeof(g_stress_registers[port_index]));
+    uart_device->registers = &g_stress_registers[port_index];
+    device_info->uart_base_address =
+        reinterpret_cast<uintptr_t>(&g_stress_registers[port_index]);
+    device_info->device_name = "stress-uart";
+    return UART_ERROR_NONE;
+}
+
+/* Poll-thread stand-in for the UART wire: drain the write FIFO, checking
+ * byte order, and feed the read FIFO with the next pattern bytes. */
+bool DrainWriteFifo(size_t port_index, size_t *io_checked)
+{
+    uart_byte_fifo_t *fifo = &uart_fifo_map.write_fifos[port_index];
+    bool order_ok = true;
+
+    while (fifo->count != 0U)
+    {
+        order_ok = order_ok && fifo->data[fifo->tail] == PatternByte(*io_checked);
+        fifo->tail = (fifo->tail + 1U) % UART_DEVICE_FIFO_SIZE_BYTES;
+        fifo->count -= 1U;
+        *io_checked += 1U;
+    }
+
+    return order_ok;
+}
+
+void FillReadFifo(size_t port_index, size_t *io_fed, size_t limit)
+{
+    uart_byte_fifo_t *fifo = &uart_fifo_map.read_fifos[port_index];
+
+    while (*io_fed < limit && fifo->count != UART_DEVICE_FIFO_SIZE_BYTES)
+    {
+        fifo->data[fifo->head] = PatternByte(*io_fed);
+        fifo->head = (fifo->head + 1U) % UART_DEVICE_FIFO_SIZE_BYTES;
+        fifo->count += 1U;
+        *io_fed += 1U;
+    }
+}
+
+} // namespace
+
+TEST(SerialQueueConcurrencyTest, SpscByteQueuePreservesOrderUnderContention)
+{
+    static serial_queue_t queue;
+    static serial_queue_buffer_t buffer;
+    std::atomic<bool> order_ok{true};
+
+    ASSERT_EQ(serial_queue_init_bytes(&queue, &buffer), UART_ERROR_NONE);
+
+    std::thread producer([] {
+        uint8_t chunk[97];
+        size_t produced = 0U;
+        size_t step = 1U;
+
+        while (produced < kStressBytes)
+        {
+            size_t length = (step++ % sizeof(chunk)) + 1U;
+            size_t pushed = 0U;
+
+            if (length > kStressBytes - produced)
+            {
+                length = kStressBytes - produced;
+            }
+            for (size_t i = 0U; i < length; ++i)
+            {
+                chunk[i] = PatternByte(produced + i);
+            }
+            (void)serial_queue_push_bytes(&queue, chunk, length, &pushed);
+            produced += pushed;
+            if (pushed == 0U)
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread consumer([&order_ok] {
+        uint8_t chunk[131];
+        size_t consumed = 0U;
+        size_t step = 3U;
+
+        while (consumed < kStressBytes)
+        {
+            const size_t length = (step++ % sizeof(chunk)) + 1U;
+            size_t popped = 0U;
+
+            (void)serial_queue_pop_bytes(&queue, chunk, length, &popped);
+            for (size_t i = 0U; i < popped; ++i)
+            {
+                if (chunk[i] != PatternByte(consumed + i))
+                {
+                    order_ok = false;
+                }
+            }
+            consumed += popped;
+            if (popped == 0U)
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    EXPECT_TRUE(order_ok);
+    EXPECT_TRUE(serial_queue_is_empty(&queue));
+}
+
+TEST(SerialQueueConcurrencyTest, WriterPollerAndReaderPreserveOrderWithoutLocks)
+{
+    constexpr size_t kPort = SERIAL_PORT_7;
+    constexpr size_t kDriverBytes = 128U * 1024U;
+    std::atomic<bool> done{false};
+    std::atomic<bool> order_ok{true};
+
+    ASSERT_EQ(serial_driver_hw_set_mapper(StressMapper), UART_ERROR_NONE);
+    ASSERT_EQ(serial_driver_reset(), SERIAL_DRIVER_OK);
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+
+    std::thread writer([descriptor] {
+        uint8_t chunk[61];
+        size_t produced = 0U;
+
+        while (produced < kDriverBytes)
+        {
+            size_t length = sizeof(chunk);
+            size_t written = 0U;
+
+            if (length > kDriverBytes - produced)
+            {
+                length = kDriverBytes - produced;
+            }
+            for (size_t i = 0U; i < length; ++i)
+            {
+                chunk[i] = PatternByte(produced + i);
+            }
+            (void)serial_driver_write(descriptor, chunk, length, &written);
+            produced += written;
+            if (written == 0U)
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread poller([descriptor, &done, &order_ok] {
+        size_t checked = 0U;
+        size_t fed = 0U;
+
+        while (!done)
+        {
+            size_t tx_bytes = 0U;
+            size_t rx_bytes = 0U;
+
+            FillReadFifo(kPort, &fed, kDriverBytes);
+            (void)serial_driver_poll(descriptor, UART_DEVICE_FIFO_SIZE_BYTES,
+                                     UART_DEVICE_FIFO_SIZE_BYTES, &tx_bytes,
+                                     &rx_bytes);
+            if (!DrainWriteFifo(kPort, &checked))
+            {
+                order_ok = false;
+            }
+            if (tx_bytes == 0U && rx_bytes == 0U)
+            {
+                std::this_thread::yield();
+            }
+        }
+        if (checked != kDriverBytes)
+        {
+            order_ok = false;
+        }
+    });
+
+    std::thread reader([descriptor, &order_ok] {
+        uint8_t chunk[173];
+        size_t consumed = 0U;
+
+        while (consumed < kDriverBytes)
+        {
+            size_t bytes_read = 0U;
+
+            (void)serial_driver_read(descriptor, chunk, sizeof(chunk),
+                                     &bytes_read);
+            for (size_t i = 0U; i < bytes_read; ++i)
+            {
+                if (chunk[i] != PatternByte(consumed + i))
+                {
+                    order_ok = false;
+                }
+            }
+            consumed += bytes_read;
+            if (bytes_read == 0U)
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    writer.join();
+    reader.join();
+    /* Let the poller flush the TX bytes still queued behind the reader; it
+     * stays the only thread that polls the port. */
+    while (!serial_queue_is_empty(uart_devices[kPort].tx_queue))
+    {
+        std::this_thread::yield();
+    }
+    done = true;
+    poller.join();
+    EXPECT_EQ(serial_driver_reset(), SERIAL_DRIVER_OK);
+    serial_driver_hw_reset_mapper();
+
+    EXPECT_TRUE(order_ok);
+}
+
+TEST(SerialQueueConcurrencyTest, MultiProducerWritesStayContiguous)
+{
+    constexpr size_t kProducers = 4U;
+    constexpr size_t kMessagesPerProducer = 4096U;
+    constexpr size_t kMessageBytes = 24U;
+    static serial_queue_t queue;
+    static serial_queue_buffer_t buffer;
+    std::atomic<bool> order_ok{true};
+    /* Set by the consumer when it gives up, so producers stop retrying. */
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> producers;
+
+    ASSERT_EQ(serial_queue_init_bytes(&queue, &buffer), UART_ERROR_NONE);
+
+    for (size_t producer = 0U; producer < kProducers; ++producer)
+    {
+        producers.emplace_back([producer, &stop] {
+            uint8_t message[kMessageBytes];
+
+            for (size_t sequence = 0U; sequence < kMessagesPerProducer;
+                 ++sequence)
+            {
+                message[0] = static_cast<uint8_t>(producer);
+                message[1] = static_cast<uint8_t>(sequence & 0xFFU);
+                for (size_t i = 2U; i < kMessageBytes; ++i)
+                {
+                    message[i] = static_cast<uint8_t>(producer * 16U + i);
+                }
+                while (serial_queue_push_bytes_mp(&queue, message,
+                                                  sizeof(message)) ==
+                       UART_ERROR_FIFO_QUEUE_FULL)
+                {
+                    if (stop)
+                    {
+                        return;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::thread consumer([&order_ok, &stop] {
+        uint8_t message[kMessageBytes];
+        size_t next_sequence[kProducers] = {};
+        size_t received = 0U;
+        size_t filled = 0U;
+
+        while (received < kProducers * kMessagesPerProducer)
+        {
+            size_t popped = 0U;
+
+            (void)serial_queue_pop_bytes(&queue, &message[filled],
+                                         kMessageBytes - filled, &popped);
+            filled += popped;
+            if (filled < kMessageBytes)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            const size_t producer = message[0];
+            if (producer >= kProducers ||
+                message[1] != (next_sequence[producer] & 0xFFU))
+            {
+                order_ok = false;
+                stop = true;
+                break;
+            }
+            for (size_t i = 2U; i < kMessageBytes; ++i)
+            {
+                if (message[i] != static_cast<uint8_t>(producer * 16U + i))
+                {
+                    order_ok = false;
+                }
+            }
+            next_sequence[producer] += 1U;
+            received += 1U;
+            filled = 0U;
+        }
+    });
+
+    for (std::thread &producer : producers)
+    {
+        producer.join();
+    }
+    consumer.join();
+
+    EXPECT_TRUE(order_ok);
+    EXPECT_TRUE(serial_queue_is_empty(&queue));
+}
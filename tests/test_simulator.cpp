@@ -0,0 +1,258 @@
+#include <array>
+#include <cstdint>
+
+extern "C"
+{
+#include "device_driver/device_driver.h"
+#include "device_driver/simulator.h"
+
+    /* Test-only hook defined in device_driver.c. */
+    serial_driver_error_t serial_driver_reset(void);
+}
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+/* 115200 baud 8N1: ten bits of 8680.55 ns. */
+constexpr uint64_t kDefaultCharNs = 86805U;
+
+size_t PollRx(serial_descriptor_t descriptor)
+{
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+
+    EXPECT_EQ(serial_driver_poll(descriptor, 0U, UART_DEVICE_FIFO_SIZE_BYTES,
+                                 &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    return rx_bytes;
+}
+
+void WriteAndPollTx(serial_descriptor_t descriptor, const uint8_t *data,
+                    size_t length)
+{
+    size_t written = 0U;
+    size_t tx_bytes = 0U;
+    size_t rx_bytes = 0U;
+
+    ASSERT_EQ(serial_driver_write(descriptor, data, length, &written),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(written, length);
+    ASSERT_EQ(serial_driver_poll(descriptor, length, 0U, &tx_bytes, &rx_bytes),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(tx_bytes, length);
+}
+
+} // namespace
+
+class SerialDriverSimTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(serial_driver_reset(), SERIAL_DRIVER_OK);
+        ASSERT_EQ(serial_driver_sim_install(), UART_ERROR_NONE);
+    }
+
+    void TearDown() override
+    {
+        serial_driver_sim_uninstall();
+        EXPECT_EQ(serial_driver_reset(), SERIAL_DRIVER_OK);
+    }
+};
+
+TEST_F(SerialDriverSimTest, LoopbackDeliversOneByteEveryCharacterTime)
+{
+    constexpr size_t kPort = SERIAL_PORT_0;
+    const std::array<uint8_t, 10> payload{
+        {0x00U, 0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x66U, 0x77U, 0x88U, 0x99U}};
+    std::array<uint8_t, payload.size()> received{};
+    serial_driver_sim_stats_t stats = {};
+    size_t bytes_read = 0U;
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_EQ(serial_driver_enable_loopback(descriptor), SERIAL_DRIVER_OK);
+    EXPECT_EQ(serial_driver_sim_char_time_ns(kPort), kDefaultCharNs);
+
+    WriteAndPollTx(descriptor, payload.data(), payload.size());
+
+    /* Nothing arrives before the first stop bit has gone out. */
+    serial_driver_sim_advance(kDefaultCharNs);
+    EXPECT_EQ(uart_fifo_map.read_fifos[kPort].count, 0U);
+    serial_driver_sim_advance(1U);
+    EXPECT_EQ(uart_fifo_map.read_fifos[kPort].count, 1U);
+    EXPECT_NE(uart_devices[kPort].registers->uart.lsr & UART_LSR_DATA_READY_BIT,
+              0U);
+
+    serial_driver_sim_advance(4U * (kDefaultCharNs + 1U));
+    EXPECT_EQ(uart_fifo_map.read_fifos[kPort].count, 5U);
+    serial_driver_sim_advance(10U * kDefaultCharNs);
+    EXPECT_EQ(uart_fifo_map.read_fifos[kPort].count, payload.size());
+
+    ASSERT_EQ(PollRx(descriptor), payload.size());
+    ASSERT_EQ(serial_driver_read(descriptor, received.data(), received.size(),
+                                 &bytes_read),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(received, payload);
+
+    serial_driver_sim_advance(0U);
+    EXPECT_EQ(uart_devices[kPort].registers->uart.lsr & UART_LSR_DATA_READY_BIT,
+              0U);
+    ASSERT_EQ(serial_driver_sim_get_stats(kPort, &stats), UART_ERROR_NONE);
+    EXPECT_EQ(stats.tx_bytes, payload.size());
+    EXPECT_EQ(stats.rx_bytes, payload.size());
+    EXPECT_EQ(stats.dropped, 0U);
+}
+
+TEST_F(SerialDriverSimTest, CharacterTimeFollowsDivisorSamplingAndFormat)
+{
+    constexpr size_t kPort = SERIAL_PORT_1;
+    const uint8_t byte = 0x5AU;
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_EQ(serial_port_configure(descriptor, 15625000U, 7U,
+                                    SERIAL_PARITY_EVEN, SERIAL_STOP_BITS_2),
+              SERIAL_DRIVER_OK);
+
+    /* 7E2 is eleven bits; 15.625 Mbaud needs 8X sampling. */
+    const xr17c358_channel_register_map_t *registers =
+        uart_devices[kPort].registers;
+    const uint64_t divisor =
+        registers->uart.data.dll |
+        (static_cast<uint64_t>(registers->uart.interrupt_enable.dlm) << 8U);
+    const uint64_t sampling =
+        (registers->device_config.generic.mode_8x & (1U << kPort)) != 0U ? 8U
+        : (registers->device_config.generic.mode_4x & (1U << kPort)) != 0U
+            ? 4U
+            : 16U;
+    ASSERT_NE(divisor, 0U);
+    ASSERT_EQ(sampling, 8U);
+    const uint64_t char_ns =
+        11U * sampling * divisor * 1000000000ULL / SERIAL_DRIVER_UART_CLOCK_HZ;
+    EXPECT_EQ(serial_driver_sim_char_time_ns(kPort), char_ns);
+
+    ASSERT_EQ(serial_driver_enable_loopback(descriptor), SERIAL_DRIVER_OK);
+    WriteAndPollTx(descriptor, &byte, 1U);
+    serial_driver_sim_advance(char_ns - 1U);
+    EXPECT_EQ(uart_fifo_map.read_fifos[kPort].count, 0U);
+    serial_driver_sim_advance(2U);
+    EXPECT_EQ(uart_fifo_map.read_fifos[kPort].count, 1U);
+}
+
+TEST_F(SerialDriverSimTest, NullModemCableCarriesDataAndRtsBothWays)
+{
+    constexpr size_t kPortA = SERIAL_PORT_2;
+    constexpr size_t kPortB = SERIAL_PORT_3;
+    const std::array<uint8_t, 3> to_b{{0x01U, 0x02U, 0x03U}};
+    const std::array<uint8_t, 2> to_a{{0xA1U, 0xA2U}};
+    std::array<uint8_t, 3> received{};
+    serial_driver_sim_stats_t stats = {};
+    size_t bytes_read = 0U;
+
+    const serial_descriptor_t port_a = serial_port_init(
+        static_cast<serial_ports_t>(kPortA), UART_PORT_MODE_SERIAL);
+    const serial_descriptor_t port_b = serial_port_init(
+        static_cast<serial_ports_t>(kPortB), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(port_a, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_NE(port_b, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_EQ(serial_driver_sim_connect(kPortA, kPortB), UART_ERROR_NONE);
+
+    uart_devices[kPortA].registers->uart.mcr |= UART_MCR_RTS_BIT;
+    serial_driver_sim_advance(0U);
+    EXPECT_NE(uart_devices[kPortB].registers->uart.msr_or_rs485dly.msr &
+                  UART_MSR_CTS_BIT,
+              0U);
+    EXPECT_EQ(uart_devices[kPortA].registers->uart.msr_or_rs485dly.msr &
+                  UART_MSR_CTS_BIT,
+              0U);
+
+    WriteAndPollTx(port_a, to_b.data(), to_b.size());
+    WriteAndPollTx(port_b, to_a.data(), to_a.size());
+    serial_driver_sim_advance(3U * (kDefaultCharNs + 1U));
+
+    ASSERT_EQ(PollRx(port_b), to_b.size());
+    ASSERT_EQ(serial_driver_read(port_b, received.data(), received.size(),
+                                 &bytes_read),
+              SERIAL_DRIVER_OK);
+    EXPECT_EQ(received, to_b);
+    ASSERT_EQ(PollRx(port_a), to_a.size());
+    ASSERT_EQ(serial_driver_read(port_a, received.data(), received.size(),
+                                 &bytes_read),
+              SERIAL_DRIVER_OK);
+    ASSERT_EQ(bytes_read, to_a.size());
+    EXPECT_EQ(received[0], to_a[0]);
+    EXPECT_EQ(received[1], to_a[1]);
+
+    /* Unplugged, bytes go nowhere. */
+    ASSERT_EQ(serial_driver_sim_disconnect(kPortB), UART_ERROR_NONE);
+    WriteAndPollTx(port_a, to_b.data(), 1U);
+    serial_driver_sim_advance(kDefaultCharNs + 1U);
+    EXPECT_EQ(uart_fifo_map.read_fifos[kPortB].count, 0U);
+    ASSERT_EQ(serial_driver_sim_get_stats(kPortA, &stats), UART_ERROR_NONE);
+    EXPECT_EQ(stats.tx_bytes, to_b.size() + 1U);
+    EXPECT_EQ(stats.dropped, 1U);
+
+    EXPECT_EQ(serial_driver_sim_connect(kPortA, kPortA),
+              UART_ERROR_INVALID_ARG);
+    EXPECT_EQ(serial_driver_sim_connect(kPortA, UART_DEVICE_COUNT),
+              UART_ERROR_INVALID_ARG);
+}
+
+TEST_F(SerialDriverSimTest, AutoCtsHoldsTransmitterUntilPeerRaisesRts)
+{
+    constexpr size_t kPortA = SERIAL_PORT_4;
+    constexpr size_t kPortB = SERIAL_PORT_5;
+    const uint8_t byte = 0x42U;
+
+    const serial_descriptor_t port_a = serial_port_init(
+        static_cast<serial_ports_t>(kPortA), UART_PORT_MODE_SERIAL);
+    const serial_descriptor_t port_b = serial_port_init(
+        static_cast<serial_ports_t>(kPortB), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(port_a, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_NE(port_b, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_EQ(serial_driver_sim_connect(kPortA, kPortB), UART_ERROR_NONE);
+
+    uart_devices[kPortA].registers->uart.efr |= XR17V358_EFR_AUTO_CTS_BIT;
+    WriteAndPollTx(port_a, &byte, 1U);
+    serial_driver_sim_advance(10U * kDefaultCharNs);
+    EXPECT_EQ(uart_fifo_map.write_fifos[kPortA].count, 1U);
+    EXPECT_EQ(uart_fifo_map.read_fifos[kPortB].count, 0U);
+
+    uart_devices[kPortB].registers->uart.mcr |= UART_MCR_RTS_BIT;
+    serial_driver_sim_advance(kDefaultCharNs + 1U);
+    EXPECT_EQ(uart_fifo_map.write_fifos[kPortA].count, 0U);
+    EXPECT_EQ(uart_fifo_map.read_fifos[kPortB].count, 1U);
+}
+
+TEST_F(SerialDriverSimTest, FullReceiveFifoCountsOverruns)
+{
+    constexpr size_t kPort = SERIAL_PORT_6;
+    constexpr size_t kExtra = 4U;
+    std::array<uint8_t, UART_DEVICE_FIFO_SIZE_BYTES> payload{};
+    serial_driver_sim_stats_t stats = {};
+
+    const serial_descriptor_t descriptor = serial_port_init(
+        static_cast<serial_ports_t>(kPort), UART_PORT_MODE_SERIAL);
+    ASSERT_NE(descriptor, SERIAL_DESCRIPTOR_INVALID);
+    ASSERT_EQ(serial_driver_enable_loopback(descriptor), SERIAL_DRIVER_OK);
+
+    WriteAndPollTx(descriptor, payload.data(), payload.size());
+    serial_driver_sim_advance(payload.size() * kDefaultCharNs + 1000U);
+    EXPECT_EQ(uart_fifo_map.read_fifos[kPort].count,
+              UART_DEVICE_FIFO_SIZE_BYTES);
+    EXPECT_EQ(uart_devices[kPort].registers->uart.lsr & UART_LSR_OVERRUN_BIT,
+              0U);
+
+    WriteAndPollTx(descriptor, payload.data(), kExtra);
+    serial_driver_sim_advance(kExtra * kDefaultCharNs + 1000U);
+    ASSERT_EQ(serial_driver_sim_get_stats(kPort, &stats), UART_ERROR_NONE);
+    EXPECT_EQ(stats.rx_bytes, UART_DEVICE_FIFO_SIZE_BYTES);
+    EXPECT_EQ(stats.overruns, kExtra);
+    EXPECT_NE(uart_devices[kPort].registers->uart.lsr & UART_LSR_OVERRUN_BIT,
+              0U);
+}